@@ -0,0 +1,43 @@
+# 不依赖界面的模式引擎，界面（ListHunter.pro）和命令行（cli/listhunter-cli.pro）共用
+# 只依赖 QtCore 和 QtConcurrent
+# DEFINES += LISTHUNTER_COUNT_ALLOCS 时统计 malloc 次数（会替换 glibc 的分配函数），默认只有基准测试启用
+
+QT += core concurrent
+
+INCLUDEPATH += \
+    $$PWD \
+    $$PWD/utils/
+
+SOURCES += \
+    $$PWD/listhuntercore.cpp \
+    $$PWD/searchrunner.cpp \
+    $$PWD/commandline.cpp \
+    $$PWD/linepipeline.cpp \
+    $$PWD/searchtrace.cpp \
+    $$PWD/linematcher.cpp \
+    $$PWD/lineprefilter.cpp \
+    $$PWD/resultstore.cpp \
+    $$PWD/resultspill.cpp \
+    $$PWD/resultquery.cpp \
+    $$PWD/nativesource.cpp \
+    $$PWD/actionexecutor.cpp \
+    $$PWD/processlimiter.cpp \
+    $$PWD/alloccounter.cpp
+
+HEADERS += \
+    $$PWD/listhuntercore.h \
+    $$PWD/modebean.h \
+    $$PWD/searchrunner.h \
+    $$PWD/commandline.h \
+    $$PWD/linepipeline.h \
+    $$PWD/searchtrace.h \
+    $$PWD/linematcher.h \
+    $$PWD/lineprefilter.h \
+    $$PWD/resultstore.h \
+    $$PWD/resultspill.h \
+    $$PWD/resultquery.h \
+    $$PWD/nativesource.h \
+    $$PWD/actionexecutor.h \
+    $$PWD/processlimiter.h \
+    $$PWD/alloccounter.h \
+    $$PWD/utils/myjson.h
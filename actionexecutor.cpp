@@ -0,0 +1,105 @@
+#include <QDebug>
+#include <QTimer>
+#include "actionexecutor.h"
+#include "processlimiter.h"
+
+ActionExecutor::ActionExecutor(QObject *parent) : QObject(parent)
+{
+    connect(ProcessLimiter::instance(), SIGNAL(available()), this, SLOT(limiterAvailable()), Qt::QueuedConnection);
+}
+
+ActionExecutor::~ActionExecutor()
+{
+    queue.clear();
+    for (QProcess* process: running.keys())
+    {
+        process->disconnect(this);
+        process->kill();
+        process->waitForFinished(100);
+        delete process;
+        ProcessLimiter::instance()->release();
+    }
+    running.clear();
+}
+
+void ActionExecutor::setMaxRunning(int count)
+{
+    maxCount = qMax(1, count);
+    if (!queue.isEmpty())
+        startNext();
+}
+
+int ActionExecutor::enqueue(const CommandLine &cmd)
+{
+    Task task;
+    task.id = nextId++;
+    task.cmd = cmd;
+    queue.enqueue(task);
+
+    // 调用方先记下任务序号，再收到 taskStarted
+    if (!startQueued)
+    {
+        startQueued = true;
+        QTimer::singleShot(0, this, SLOT(startNext()));
+    }
+    return task.id;
+}
+
+bool ActionExecutor::isIdle() const
+{
+    return queue.isEmpty() && running.isEmpty();
+}
+
+/// 同时受本队列的 maxRunning 和全局 ProcessLimiter 限制，没有名额时等 limiterAvailable 再继续
+void ActionExecutor::startNext()
+{
+    startQueued = false;
+    while (running.size() < maxCount && !queue.isEmpty() && ProcessLimiter::instance()->acquire())
+    {
+        Task task = queue.dequeue();
+        QProcess* process = new QProcess(this);
+        process->setProcessChannelMode(QProcess::MergedChannels);
+        connect(process, SIGNAL(finished(int, QProcess::ExitStatus)), this, SLOT(processFinished(int, QProcess::ExitStatus)));
+        connect(process, SIGNAL(errorOccurred(QProcess::ProcessError)), this, SLOT(processError(QProcess::ProcessError)));
+        running.insert(process, task.id);
+        emit taskStarted(task.id);
+        task.cmd.start(process);
+    }
+}
+
+void ActionExecutor::limiterAvailable()
+{
+    if (!startQueued && !queue.isEmpty())
+        startNext();
+}
+
+void ActionExecutor::processFinished(int exitCode, QProcess::ExitStatus status)
+{
+    QProcess* process = qobject_cast<QProcess*>(sender());
+    if (!process || !running.contains(process))
+        return ;
+    QString output = QString::fromLocal8Bit(process->readAll()).trimmed();
+    finishTask(process, exitCode, status == QProcess::NormalExit, output);
+}
+
+/// 启动失败时不会再有 finished，其余错误等 finished 处理
+void ActionExecutor::processError(QProcess::ProcessError error)
+{
+    QProcess* process = qobject_cast<QProcess*>(sender());
+    if (error != QProcess::FailedToStart || !process || !running.contains(process))
+        return ;
+    finishTask(process, -1, false, process->errorString());
+}
+
+void ActionExecutor::finishTask(QProcess *process, int exitCode, bool ok, const QString &output)
+{
+    int id = running.take(process);
+    process->disconnect(this);
+    process->deleteLater();
+    ProcessLimiter::instance()->release();
+    emit taskFinished(id, exitCode, ok, output);
+
+    startNext();
+    if (isIdle())
+        emit allFinished();
+}
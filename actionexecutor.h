@@ -0,0 +1,55 @@
+#ifndef ACTIONEXECUTOR_H
+#define ACTIONEXECUTOR_H
+
+#include <QObject>
+#include <QProcess>
+#include <QQueue>
+#include <QHash>
+#include "commandline.h"
+
+/**
+ * 异步执行右键动作的命令
+ * 命令排队后最多同时运行 maxRunning 个进程（同时受 ProcessLimiter 的全局上限限制），不阻塞界面线程
+ * 每个命令结束时发出 taskFinished，队列全部执行完后发出 allFinished
+ */
+class ActionExecutor : public QObject
+{
+    Q_OBJECT
+public:
+    explicit ActionExecutor(QObject *parent = nullptr);
+    ~ActionExecutor() override;
+
+    void setMaxRunning(int count);
+    int maxRunning() const { return maxCount; }
+
+    int enqueue(const CommandLine& cmd); // 返回任务序号，下一轮事件循环才开始执行
+    bool isIdle() const;
+
+signals:
+    void taskStarted(int task);
+    void taskFinished(int task, int exitCode, bool ok, const QString& output); // 启动失败或异常退出时 ok 为 false
+    void allFinished();
+
+private slots:
+    void startNext();
+    void limiterAvailable();
+    void processFinished(int exitCode, QProcess::ExitStatus status);
+    void processError(QProcess::ProcessError error);
+
+private:
+    void finishTask(QProcess* process, int exitCode, bool ok, const QString& output);
+
+private:
+    struct Task
+    {
+        int id;
+        CommandLine cmd;
+    };
+    QQueue<Task> queue;
+    QHash<QProcess*, int> running; // 进程 -> 任务序号
+    int maxCount = 4;
+    int nextId = 0;
+    bool startQueued = false;
+};
+
+#endif // ACTIONEXECUTOR_H
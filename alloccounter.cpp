@@ -0,0 +1,73 @@
+#include <atomic>
+#include <stddef.h>
+#include "alloccounter.h"
+
+#if defined(Q_OS_UNIX)
+#include <sys/resource.h>
+#endif
+
+// 替换分配函数会让每次分配多一次原子操作，也会和其他分配器、sanitizer 冲突，只在定义了 LISTHUNTER_COUNT_ALLOCS 的构建（基准测试）中启用
+#if defined(__GLIBC__) && defined(LISTHUNTER_COUNT_ALLOCS)
+static std::atomic<quint64> allocations(0);
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+
+// 覆盖 glibc 的分配函数，Qt 库中的分配也会经过这里
+void* malloc(size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(ptr, size);
+}
+}
+
+quint64 allocationCount()
+{
+    return allocations.load(std::memory_order_relaxed);
+}
+
+bool allocationCountAvailable()
+{
+    return true;
+}
+#else
+quint64 allocationCount()
+{
+    return 0;
+}
+
+bool allocationCountAvailable()
+{
+    return false;
+}
+#endif
+
+qint64 peakRssKB()
+{
+#if defined(Q_OS_UNIX)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return -1;
+#if defined(Q_OS_MACOS)
+    return usage.ru_maxrss / 1024; // macOS 单位为字节
+#else
+    return usage.ru_maxrss;
+#endif
+#else
+    return -1;
+#endif
+}
@@ -0,0 +1,15 @@
+#ifndef ALLOCCOUNTER_H
+#define ALLOCCOUNTER_H
+
+#include <QtGlobal>
+
+/**
+ * 进程内 malloc 调用计数（QString、QVector 的内存都经过 malloc），SearchTrace 按阶段记录，基准测试按行统计
+ * 仅 glibc 下、并且定义了 LISTHUNTER_COUNT_ALLOCS 时可用，否则 allocationCountAvailable() 为 false
+ */
+quint64 allocationCount();
+bool allocationCountAvailable();
+
+qint64 peakRssKB(); // 进程到目前为止的内存峰值，不支持的平台为 -1
+
+#endif // ALLOCCOUNTER_H
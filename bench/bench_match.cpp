@@ -0,0 +1,411 @@
+#include <QtTest>
+#include <QDir>
+#include <QHash>
+#include <QThread>
+#include <ctime>
+#include "listhuntercore.h"
+#include "linematcher.h"
+#include "resultquery.h"
+#include "actionexecutor.h"
+#include "alloccounter.h"
+#include "nativesource.h"
+
+/**
+ * 模式解析输出的基准：modes/ 下的每个模式使用录制的命令输出，
+ * 按行循环扩展到 1k、100k、1M 行，走与 search() 相同的 appendText + matchInto 流程
+ * 除 QBENCHMARK 的耗时外，另外输出每秒行数、每行分配次数和进程内存峰值
+ */
+class BenchMatch : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void match_data();
+    void match();
+    void query_data();
+    void query();
+    void spawn_data();
+    void spawn();
+    void spill_data();
+    void spill();
+    void threads_data();
+    void threads();
+    void sockdiag_data();
+    void sockdiag();
+
+private:
+    struct Fixture
+    {
+        QString file; // bench/fixtures 下录制的输出
+        int headerLines; // 开头只出现一次的标题行
+    };
+    QString scaledOutput(const Fixture& fixture, int lines);
+    static void feed(const ListHunterCore& core, ResultStore& store, const QString& text);
+
+private:
+    QHash<QString, QString> outputs; // 已经扩展好的输出，多个模式共用
+};
+
+/// 基础命令 -> 录制的输出
+static QHash<QString, QPair<QString, int>> fixtureTable()
+{
+    QHash<QString, QPair<QString, int>> table;
+    table.insert("netstat -pe", qMakePair(QString("netstat-pe.txt"), 2));
+    table.insert("netstat -ano", qMakePair(QString("netstat-ano.txt"), 4));
+    table.insert("ps -ef", qMakePair(QString("ps-ef.txt"), 1));
+    table.insert("tasklist", qMakePair(QString("tasklist.txt"), 3));
+    return table;
+}
+
+void BenchMatch::match_data()
+{
+    QTest::addColumn<QString>("modeFile");
+    QTest::addColumn<QString>("fixture");
+    QTest::addColumn<int>("headerLines");
+    QTest::addColumn<int>("lines");
+
+    auto table = fixtureTable();
+    QDir dir(LISTHUNTER_SOURCE_DIR "/modes");
+    for (const QString& name: dir.entryList(QStringList{"*.json"}, QDir::Files, QDir::Name))
+    {
+        ListHunterCore core;
+        QStringList errors;
+        if (!core.loadModeFile(dir.filePath(name), &errors))
+        {
+            qWarning() << "跳过无法加载的模式：" << name << errors;
+            continue;
+        }
+        if (!core.mode().source.isEmpty())
+            continue; // 内置数据源没有命令输出
+        QString cmd = core.mode().searchCmd("").text();
+        if (!table.contains(cmd))
+        {
+            qWarning() << "跳过没有录制输出的模式：" << name << cmd;
+            continue;
+        }
+
+        auto fixture = table.value(cmd);
+        for (int lines: {1000, 100000, 1000000})
+        {
+            QString tag = QString("%1/%2k").arg(name).arg(lines / 1000);
+            QTest::newRow(tag.toUtf8()) << dir.filePath(name) << fixture.first << fixture.second << lines;
+        }
+    }
+}
+
+void BenchMatch::match()
+{
+    QFETCH(QString, modeFile);
+    QFETCH(QString, fixture);
+    QFETCH(int, headerLines);
+    QFETCH(int, lines);
+
+    ListHunterCore core;
+    QStringList errors;
+    QVERIFY2(core.loadModeFile(modeFile, &errors), qPrintable(errors.join("\n")));
+    Fixture f;
+    f.file = fixture;
+    f.headerLines = headerLines;
+    QString text = scaledOutput(f, lines);
+    QVERIFY(!text.isEmpty());
+
+    // 单独跑一次，统计速度和分配次数
+    ResultStore store;
+    store.reset(core.mode().captureColumns());
+    quint64 allocBefore = allocationCount();
+    QElapsedTimer timer;
+    timer.start();
+    feed(core, store, text);
+    qint64 ns = qMax(qint64(1), timer.nsecsElapsed());
+    quint64 allocs = allocationCount() - allocBefore;
+    QVERIFY(store.rowCount() > 0);
+
+    QString report = QString("lines: %1  rows: %2  lines/sec: %3")
+            .arg(store.lineCount()).arg(store.rowCount())
+            .arg(qint64(store.lineCount() * 1e9 / ns));
+    if (allocationCountAvailable())
+    {
+        // 同一个 store 重置后再解析一次，相当于稳定后的定时刷新
+        store.reset(core.mode().captureColumns());
+        allocBefore = allocationCount();
+        feed(core, store, text);
+        quint64 steady = allocationCount() - allocBefore;
+        report += QString("  allocs/line: %1  refresh_allocs/line: %2")
+                .arg(double(allocs) / store.lineCount(), 0, 'f', 3)
+                .arg(double(steady) / store.lineCount(), 0, 'f', 3);
+    }
+    if (peakRssKB() >= 0)
+        report += QString("  peak_rss: %1 MB").arg(peakRssKB() / 1024.0, 0, 'f', 1);
+    qInfo().noquote() << report;
+
+    QBENCHMARK {
+        store.reset(core.mode().captureColumns());
+        feed(core, store, text);
+    }
+}
+
+/// 列查询：Linux_Port.json 匹配好的结果上筛选和排序，不再执行命令
+void BenchMatch::query_data()
+{
+    QTest::addColumn<QString>("queryText");
+    QTest::addColumn<int>("lines");
+
+    for (int lines: {100000, 1000000})
+    {
+        for (QString text: {"state=LISTEN", "pid>1000 sort:-pid", "local>:1024 sort:local,-inode"})
+        {
+            QString tag = QString("%1/%2k").arg(text).arg(lines / 1000);
+            QTest::newRow(tag.toUtf8()) << text << lines;
+        }
+    }
+}
+
+void BenchMatch::query()
+{
+    QFETCH(QString, queryText);
+    QFETCH(int, lines);
+
+    ListHunterCore core;
+    QStringList errors;
+    QVERIFY2(core.loadModeFile(LISTHUNTER_SOURCE_DIR "/modes/Linux_Port.json", &errors), qPrintable(errors.join("\n")));
+    Fixture f;
+    f.file = "netstat-pe.txt";
+    f.headerLines = 2;
+    ResultStore store;
+    store.reset(core.mode().captureColumns());
+    feed(core, store, scaledOutput(f, lines));
+    QVERIFY(store.rowCount() > 0);
+
+    const ModeBean& mode = core.mode();
+    QString rest, error;
+    ResultQuery query = ResultQuery::parse(queryText, mode.resultTitles, mode.columnKeys, mode.columnTypes, &rest, &error);
+    QVERIFY2(error.isEmpty() && rest.isEmpty(), qPrintable(error + rest));
+    QVector<int> all = store.rowsContaining("");
+
+    // 第一次包含解析整列的耗时，之后使用缓存的列
+    QElapsedTimer timer;
+    timer.start();
+    QVector<int> rows = query.apply(store, all);
+    qInfo().noquote() << QString("rows: %1 -> %2  first_ms: %3").arg(all.size()).arg(rows.size()).arg(timer.elapsed());
+
+    QBENCHMARK {
+        rows = query.apply(store, all);
+    }
+}
+
+/// 动作的启动耗时：逐条执行 1000 个 kill -0（只检查进程是否存在），对比直接启动和以前经过 /bin/sh 启动
+void BenchMatch::spawn_data()
+{
+    QTest::addColumn<QString>("cmd");
+    QTest::newRow("direct") << "kill -0 %1";
+    QTest::newRow("shell") << "/bin/sh -c 'kill -0 %1'";
+}
+
+void BenchMatch::spawn()
+{
+#if defined(Q_OS_WIN)
+    QSKIP("kill 只在 Linux 上测试");
+#endif
+    QFETCH(QString, cmd);
+    const int count = 1000;
+    CommandLine command = CommandLine(cmd).fill(QStringList{QString::number(QCoreApplication::applicationPid())}, 1);
+    QVERIFY(command.isDirect());
+
+    ActionExecutor executor;
+    executor.setMaxRunning(1); // 逐条执行，测量的是单次启动的延迟
+    int failed = 0;
+    QEventLoop loop;
+    connect(&executor, &ActionExecutor::taskFinished, [&](int, int exitCode, bool ok, const QString&) {
+        if (!ok || exitCode != 0)
+            failed++;
+    });
+    connect(&executor, &ActionExecutor::allFinished, &loop, &QEventLoop::quit);
+
+    QBENCHMARK_ONCE {
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < count; i++)
+            executor.enqueue(command);
+        loop.exec();
+        qint64 ns = timer.nsecsElapsed();
+        qInfo().noquote() << QString("spawns: %1  total_ms: %2  us/spawn: %3")
+                             .arg(count).arg(ns / 1000000).arg(ns / 1000 / count);
+    }
+    QCOMPARE(failed, 0);
+}
+
+/// 超出内存预算后写入临时文件：对比不限制和 64MB 预算时内存中的大小，并确认读回的结果相同
+void BenchMatch::spill_data()
+{
+    QTest::addColumn<int>("budgetMB");
+    QTest::newRow("unlimited") << 0;
+    QTest::newRow("64MB") << 64;
+}
+
+void BenchMatch::spill()
+{
+    QFETCH(int, budgetMB);
+    ListHunterCore core;
+    QStringList errors;
+    QVERIFY2(core.loadModeFile(LISTHUNTER_SOURCE_DIR "/modes/Linux_Port.json", &errors), qPrintable(errors.join("\n")));
+    Fixture f;
+    f.file = "netstat-pe.txt";
+    f.headerLines = 2;
+    QString text = scaledOutput(f, 1000000);
+
+    ResultStore store;
+    QBENCHMARK_ONCE {
+        store.setMemoryBudget(qint64(budgetMB) * 1024 * 1024);
+        store.reset(core.mode().captureColumns());
+        feed(core, store, text);
+    }
+    QVERIFY(store.rowCount() > 0);
+    qInfo().noquote() << QString("rows: %1  spilled: %2  memory: %3 MB")
+                         .arg(store.rowCount()).arg(store.spilledRowCount())
+                         .arg(store.memoryUsage() / 1048576.0, 0, 'f', 1);
+    if (budgetMB > 0)
+        QVERIFY(store.memoryUsage() <= qint64(budgetMB) * 1024 * 1024);
+
+    // 与全部在内存中的结果逐行对比
+    ResultStore reference;
+    reference.reset(core.mode().captureColumns());
+    feed(core, reference, text);
+    QCOMPARE(store.rowCount(), reference.rowCount());
+    for (int r = 0; r < store.rowCount(); r += 997)
+    {
+        QCOMPARE(store.rowLine(r), reference.rowLine(r));
+        for (int c = 0; c < store.columnCount(); c++)
+            QCOMPARE(store.cell(r, c), reference.cell(r, c));
+    }
+    QCOMPARE(store.rowsContaining("LISTEN"), reference.rowsContaining("LISTEN"));
+}
+
+/// 匹配线程数：同一份 1M 行的 Linux_Port.json 输出整批匹配（多线程只在一批不少于 4096 行时启用），对比每秒行数
+void BenchMatch::threads_data()
+{
+    QTest::addColumn<int>("threads");
+    QList<int> counts{1, 2, 4};
+    if (!counts.contains(QThread::idealThreadCount()))
+        counts.append(QThread::idealThreadCount());
+    for (int count: counts)
+        QTest::newRow(QString::number(count).toUtf8()) << count;
+}
+
+void BenchMatch::threads()
+{
+    QFETCH(int, threads);
+    ListHunterCore core;
+    QStringList errors;
+    QVERIFY2(core.loadModeFile(LISTHUNTER_SOURCE_DIR "/modes/Linux_Port.json", &errors), qPrintable(errors.join("\n")));
+    core.matcher()->setThreadCount(threads);
+    Fixture f;
+    f.file = "netstat-pe.txt";
+    f.headerLines = 2;
+    QString text = scaledOutput(f, 1000000);
+
+    ResultStore store;
+    qint64 best = 0;
+    QBENCHMARK {
+        store.reset(core.mode().captureColumns());
+        store.appendText(text);
+        QElapsedTimer timer;
+        timer.start();
+        core.matcher()->matchInto(store, 0, store.lineCount());
+        best = qMax(best, qint64(store.lineCount() * 1e9 / qMax(qint64(1), timer.nsecsElapsed())));
+    }
+    QVERIFY(store.rowCount() > 0);
+    qInfo().noquote() << QString("threads: %1  lines: %2  rows: %3  lines/sec: %4")
+                         .arg(core.matcher()->threadCount()).arg(store.lineCount()).arg(store.rowCount()).arg(best);
+}
+
+/// 内置数据源 sock_diag 每次刷新的 CPU 时间（含内核态）：第一次要扫描 /proc/*/fd，之后使用缓存的 socket 所属进程
+void BenchMatch::sockdiag_data()
+{
+    QTest::addColumn<QString>("source");
+    QTest::newRow("tcp") << "sock_diag:tcp";
+    QTest::newRow("udp") << "sock_diag:udp";
+}
+
+void BenchMatch::sockdiag()
+{
+#if !defined(Q_OS_LINUX)
+    QSKIP("sock_diag 只在 Linux 上可用");
+#endif
+    QFETCH(QString, source);
+    const int refreshes = 100;
+    ResultStore store;
+    QString error;
+
+    std::clock_t start = std::clock();
+    store.reset(NativeSource::titles(source).size());
+    QVERIFY2(NativeSource::read(source, "", store, &error), qPrintable(error));
+    double firstMs = double(std::clock() - start) * 1000 / CLOCKS_PER_SEC;
+
+    QBENCHMARK_ONCE {
+        start = std::clock();
+        for (int i = 0; i < refreshes; i++)
+        {
+            store.reset(NativeSource::titles(source).size());
+            QVERIFY2(NativeSource::read(source, "", store, &error), qPrintable(error));
+        }
+        double ms = double(std::clock() - start) * 1000 / CLOCKS_PER_SEC;
+        qInfo().noquote() << QString("rows: %1  first_cpu_ms: %2  cpu_ms/refresh: %3")
+                             .arg(store.rowCount()).arg(firstMs, 0, 'f', 2).arg(ms / refreshes, 0, 'f', 3);
+    }
+}
+
+/// 标题行保留一次，其余行循环重复到 lines 行
+QString BenchMatch::scaledOutput(const Fixture &fixture, int lines)
+{
+    QString key = fixture.file + "/" + QString::number(lines);
+    if (outputs.contains(key))
+        return outputs.value(key);
+
+    QFile file(LISTHUNTER_SOURCE_DIR "/bench/fixtures/" + fixture.file);
+    if (!file.open(QIODevice::ReadOnly))
+        return QString();
+    QStringList recorded = QString::fromUtf8(file.readAll()).split(QRegularExpression("\r?\n"));
+    while (!recorded.isEmpty() && recorded.last().isEmpty())
+        recorded.removeLast();
+    QStringList header = recorded.mid(0, fixture.headerLines);
+    QStringList body = recorded.mid(fixture.headerLines);
+    if (body.isEmpty())
+        return QString();
+
+    QString text;
+    text.reserve(lines * (body.first().size() + 1));
+    for (const QString& line: header)
+        text += line + "\n";
+    for (int i = header.size(); i < lines; i++)
+    {
+        text += body.at(i % body.size());
+        text += '\n';
+    }
+    outputs.insert(key, text);
+    return text;
+}
+
+/// 与 SearchRunner 一样按块送出完整的行，每块匹配一次
+void BenchMatch::feed(const ListHunterCore &core, ResultStore &store, const QString &text)
+{
+    const int chunkSize = 65536; // 约为一次管道读取的字节数
+    int pos = 0;
+    while (pos < text.size())
+    {
+        int end = qMin(pos + chunkSize, text.size());
+        if (end < text.size())
+        {
+            int newline = text.lastIndexOf('\n', end - 1);
+            if (newline >= pos)
+                end = newline + 1;
+        }
+        int first = store.appendText(text.mid(pos, end - pos));
+        core.matcher()->matchInto(store, first, store.lineCount());
+        store.spillIfNeeded();
+        pos = end;
+    }
+}
+
+QTEST_GUILESS_MAIN(BenchMatch)
+
+#include "bench_match.moc"
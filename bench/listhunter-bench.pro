@@ -0,0 +1,16 @@
+QT       += testlib
+QT       -= gui
+
+CONFIG += c++11 console testcase
+CONFIG -= app_bundle
+
+TARGET = listhunter-bench
+
+DEFINES += QT_DEPRECATED_WARNINGS
+DEFINES += LISTHUNTER_COUNT_ALLOCS # 统计分配次数，界面和命令行不启用
+DEFINES += LISTHUNTER_SOURCE_DIR=\\\"$$PWD/..\\\"
+
+include(../ListHunterCore.pri)
+
+SOURCES += \
+    bench_match.cpp
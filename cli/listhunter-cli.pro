@@ -0,0 +1,18 @@
+QT       -= gui
+
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+TARGET = listhunter-cli
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+include(../ListHunterCore.pri)
+
+SOURCES += \
+    main.cpp
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
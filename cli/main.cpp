@@ -0,0 +1,173 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QLoggingCategory>
+#include <QTextStream>
+#include <QEventLoop>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include "listhuntercore.h"
+#include "linematcher.h"
+#include "actionexecutor.h"
+
+/**
+ * 无界面运行模式文件：
+ *   listhunter-cli -m modes/Linux_Port.json -k 8080            按 TSV 输出结果
+ *   listhunter-cli -m modes/Linux_Port.json -k 8080 -f json    按 JSON 输出结果
+ *   listhunter-cli -m modes/Linux_Port.json -k 8080 -a 结束进程  对所有结果行执行动作
+ *   listhunter-cli -m modes/Linux_Journal_Stream.json          流式搜索，结果随到随输出，直到被中断
+ */
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("listhunter-cli");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("使用 ListHunter 模式文件搜索并输出结果，或对结果执行动作");
+    parser.addHelpOption();
+    QCommandLineOption modeOption(QStringList{"m", "mode"}, "模式文件", "file");
+    QCommandLineOption keyOption(QStringList{"k", "key"}, "搜索关键词，省略为搜索全部", "key");
+    QCommandLineOption formatOption(QStringList{"f", "format"}, "输出格式：tsv 或 json", "format", "tsv");
+    QCommandLineOption actionOption(QStringList{"a", "action"}, "对所有结果行执行这个名字的动作", "name");
+    QCommandLineOption jobsOption(QStringList{"j", "jobs"}, "动作同时运行的命令数", "count", "4");
+    QCommandLineOption dryRunOption(QStringList{"n", "dry-run"}, "只输出动作要执行的命令");
+    QCommandLineOption threadsOption(QStringList{"t", "match-threads"}, "匹配线程数，0 为 CPU 核心数", "count", "0");
+    QCommandLineOption memoryOption(QStringList{"memory-limit"}, "结果在内存中的上限（MB），超过后较早的行写入临时文件，0 为不限制", "mb", "512");
+    QCommandLineOption verboseOption(QStringList{"v", "verbose"}, "输出执行的命令和耗时日志");
+    parser.addOptions({modeOption, keyOption, formatOption, actionOption, jobsOption, dryRunOption, threadsOption, memoryOption, verboseOption});
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+    if (!parser.isSet(modeOption))
+    {
+        err << "缺少模式文件：-m <file>" << endl;
+        return 1;
+    }
+    if (!parser.isSet(verboseOption))
+        QLoggingCategory::setFilterRules("*.info=false");
+
+    // 加载模式
+    ListHunterCore core;
+    QStringList errors;
+    if (!core.loadModeFile(parser.value(modeOption), &errors))
+    {
+        err << "加载模式失败：" << endl << errors.join("\n") << endl;
+        return 1;
+    }
+    core.matcher()->setThreadCount(parser.value(threadsOption).toInt());
+    const ModeBean& mode = core.mode();
+
+    // 一个结果行按 TSV 或 JSON 对象输出
+    int columns = mode.resultTitles.size();
+    bool json = parser.value(formatOption) == "json";
+    auto rowObject = [&](const ResultStore& store, int r) {
+        QJsonObject obj;
+        for (int c = 0; c < columns && c < store.columnCount(); c++)
+            obj.insert(mode.resultTitles.at(c), store.cell(r, c));
+        return obj;
+    };
+    auto printRow = [&](const ResultStore& store, int r) {
+        for (int c = 0; c < columns && c < store.columnCount(); c++)
+        {
+            if (c)
+                out << "\t";
+            out << store.cellRef(r, c);
+        }
+        out << "\n";
+    };
+
+    // 流式搜索的命令不会结束：不能执行动作，结果每批输出一次，JSON 为每行一个对象
+    bool stream = false;
+    if (mode.keyFilter == ModeBean::NoKeyFilter)
+        mode.searchCmd(parser.value(keyOption), &stream);
+    ListHunterCore::RowsCallback rowsReady;
+    if (stream)
+    {
+        if (parser.isSet(actionOption))
+        {
+            err << "流式搜索不能执行动作：" << parser.value(actionOption) << endl;
+            return 1;
+        }
+        if (!json)
+            out << mode.resultTitles.join("\t") << endl;
+        rowsReady = [&](const ResultStore& store, int firstRow) {
+            for (int r = firstRow; r < store.rowCount(); r++)
+            {
+                if (json)
+                    out << QJsonDocument(rowObject(store, r)).toJson(QJsonDocument::Compact) << "\n";
+                else
+                    printRow(store, r);
+            }
+            out.flush();
+        };
+    }
+
+    // 搜索
+    ResultStore store;
+    store.setMemoryBudget(qint64(parser.value(memoryOption).toInt()) * 1024 * 1024);
+    QString error;
+    if (!core.search(parser.value(keyOption), store, &error, rowsReady))
+    {
+        err << "搜索失败：" << error.trimmed() << endl;
+        if (!store.rowCount())
+            return 1;
+    }
+
+    // 执行动作
+    if (parser.isSet(actionOption))
+    {
+        QVector<int> rows(store.rowCount());
+        for (int r = 0; r < rows.size(); r++)
+            rows[r] = r;
+        QList<CommandLine> cmds = core.actionCommands(store, rows, parser.value(actionOption));
+        if (cmds.isEmpty())
+        {
+            err << "没有可以执行动作的结果行：" << parser.value(actionOption) << endl;
+            return 1;
+        }
+        if (parser.isSet(dryRunOption))
+        {
+            for (const CommandLine& cmd: cmds)
+                out << cmd.text() << endl;
+            return 0;
+        }
+
+        ActionExecutor executor;
+        executor.setMaxRunning(parser.value(jobsOption).toInt());
+        QHash<int, QString> tasks;
+        int failed = 0;
+        QEventLoop loop;
+        QObject::connect(&executor, &ActionExecutor::taskFinished, [&](int task, int exitCode, bool ok, const QString& output) {
+            if (!ok || exitCode != 0)
+                failed++;
+            out << exitCode << "\t" << tasks.value(task) << endl;
+            if (!output.isEmpty())
+                err << output << endl;
+        });
+        QObject::connect(&executor, &ActionExecutor::allFinished, &loop, &QEventLoop::quit);
+        for (const CommandLine& cmd: cmds)
+            tasks.insert(executor.enqueue(cmd), cmd.text());
+        loop.exec();
+        return failed ? 2 : 0;
+    }
+
+    // 输出结果
+    if (stream)
+        return 0; // 已经逐批输出
+    if (json)
+    {
+        QJsonArray array;
+        for (int r = 0; r < store.rowCount(); r++)
+            array.append(rowObject(store, r));
+        out << QJsonDocument(array).toJson(QJsonDocument::Indented);
+    }
+    else
+    {
+        out << mode.resultTitles.join("\t") << "\n";
+        for (int r = 0; r < store.rowCount(); r++)
+            printRow(store, r);
+    }
+    out.flush();
+    return 0;
+}
@@ -0,0 +1,307 @@
+#include <QProcess>
+#include "commandline.h"
+#include "linepipeline.h"
+
+CommandLine::CommandLine(const QString &text, bool nativePipes) : source(text), command(text)
+{
+    if (nativePipes)
+        splitPipes();
+    if (!splitWords(command, &words))
+        words.clear();
+    resolve(QStringList(), 0, this); // 没有 %n 的命令现在就拆好参数
+}
+
+CommandLine CommandLine::fill(const QStringList &caps, int first) const
+{
+    CommandLine cmd;
+    cmd.source = source;
+    cmd.command = command;
+    for (int i = 0; i < caps.size(); i++)
+    {
+        cmd.source.replace("%" + QString::number(i + first), caps.at(i));
+        cmd.command.replace("%" + QString::number(i + first), caps.at(i));
+    }
+    resolve(caps, first, &cmd);
+    return cmd;
+}
+
+void CommandLine::start(QProcess *process) const
+{
+    if (isDirect())
+    {
+        process->start(program(), arguments());
+        return ;
+    }
+#if defined(Q_OS_WIN)
+    process->start("cmd", QStringList{"/c", command});
+#else
+    process->start("/bin/sh", QStringList{"-c", command});
+#endif
+}
+
+/**
+ * 从末尾起取出可以在进程内执行的管道命令，剩下的部分为要启动的命令
+ * 有 ||、;、& 等其他分隔时不拆分，整条交给 shell，以免改变管道作用的范围
+ */
+void CommandLine::splitPipes()
+{
+    QList<int> bars;
+    char quote = 0;
+    for (int i = 0; i < source.size(); i++)
+    {
+        QChar c = source.at(i);
+        if (quote)
+        {
+            if (c == quote)
+                quote = 0;
+            continue;
+        }
+#if defined(Q_OS_WIN)
+        if (c == '"')
+#else
+        if (c == '"' || c == '\'')
+#endif
+        {
+            quote = char(c.unicode());
+            continue;
+        }
+        if (c == '|')
+        {
+            if (i + 1 < source.size() && source.at(i + 1) == '|')
+                return ;
+            if (i > 0 && source.at(i - 1) == '|')
+                return ;
+            bars.append(i);
+            continue;
+        }
+#if defined(Q_OS_WIN)
+        if (QString("&()^\n\r").contains(c))
+#else
+        if (QString(";&()`\\\n\r").contains(c))
+#endif
+            return ;
+    }
+    if (quote || bars.isEmpty())
+        return ;
+
+    int end = source.size();
+    QVector<QVector<Word>> found;
+    for (int k = bars.size() - 1; k >= 0; k--)
+    {
+        QVector<Word> stage;
+        QStringList argv;
+        if (!splitWords(source.mid(bars.at(k) + 1, end - bars.at(k) - 1), &stage)
+                || !expandWords(stage, QStringList(), 0, &argv) || !LinePipeline::isStage(argv))
+            break;
+        found.prepend(stage);
+        end = bars.at(k);
+    }
+    QString rest = source.left(end).trimmed();
+    if (found.isEmpty() || rest.isEmpty())
+        return ;
+    command = rest;
+    stageWords = found;
+}
+
+/// 填入 %n 后得到要启动的参数和进程内的管道命令，管道命令的参数不支持时整条交给 shell
+void CommandLine::resolve(const QStringList &caps, int first, CommandLine *out) const
+{
+    out->args.clear();
+    out->stageArgs.clear();
+    for (const QVector<Word>& stage: stageWords)
+    {
+        QStringList argv;
+        if (!expandWords(stage, caps, first, &argv) || !LinePipeline::isStage(argv))
+        {
+            out->command = out->source;
+            out->stageArgs.clear();
+            return ;
+        }
+        out->stageArgs.append(argv);
+    }
+
+    QStringList argv;
+    if (!words.isEmpty() && expandWords(words, caps, first, &argv) && !argv.isEmpty() && !needsShell(argv.first()))
+        out->args = argv;
+}
+
+/**
+ * 按 shell 的规则拆分：空白分隔参数，引号内为一个整体
+ * 出现任何不能直接执行的语法（含未闭合的引号）时放弃，整条命令交给 shell
+ */
+bool CommandLine::splitWords(const QString &text, QVector<Word> *words)
+{
+    words->clear();
+    Word word;
+    bool inWord = false;
+    char quote = 0;
+    for (int i = 0; i < text.size(); i++)
+    {
+        QChar c = text.at(i);
+        if (c == '%' && i + 1 < text.size() && text.at(i + 1).isDigit())
+        {
+            Part part;
+            part.cap = text.at(++i).digitValue();
+            part.quote = quote;
+            word.append(part);
+            inWord = true;
+            continue;
+        }
+        if (quote)
+        {
+            if (c == quote)
+            {
+                quote = 0;
+                continue;
+            }
+        }
+        else
+        {
+#if defined(Q_OS_WIN)
+            bool quoteChar = (c == '"');
+#else
+            bool quoteChar = (c == '"' || c == '\'');
+#endif
+            if (quoteChar)
+            {
+                // 空的引号也是一个参数
+                quote = char(c.unicode());
+                Part part;
+                part.quote = quote;
+                word.append(part);
+                inWord = true;
+                continue;
+            }
+        }
+        if (isShellChar(c, quote))
+        {
+            words->clear();
+            return false;
+        }
+        if (!quote && c.isSpace())
+        {
+            if (inWord)
+                words->append(word);
+            word.clear();
+            inWord = false;
+            continue;
+        }
+
+        if (word.isEmpty() || word.last().cap >= 0 || word.last().quote != quote)
+        {
+            Part part;
+            part.quote = quote;
+            word.append(part);
+        }
+        word.last().text += c;
+        inWord = true;
+    }
+    if (quote)
+    {
+        words->clear();
+        return false;
+    }
+    if (inWord)
+        words->append(word);
+    return true;
+}
+
+/**
+ * 把 caps 填入各个词，得到参数列表
+ * 值中出现这个位置上 shell 会解释的字符时返回 false
+ */
+bool CommandLine::expandWords(const QVector<Word> &words, const QStringList &caps, int first, QStringList *out)
+{
+    for (const Word& w: words)
+    {
+        QString arg;
+        bool have = false; // 引号包围的空字符串也是一个参数
+        for (const Part& part: w)
+        {
+            if (part.cap < 0)
+            {
+                arg += part.text;
+                have = have || part.quote || !part.text.isEmpty();
+                continue;
+            }
+
+            int index = part.cap - first;
+            if (index < 0 || index >= caps.size())
+            {
+                arg += "%" + QString::number(part.cap);
+                have = true;
+                continue;
+            }
+            const QString& value = caps.at(index);
+            for (QChar c: value)
+            {
+                if (isShellChar(c, part.quote) || c == '"' || (part.quote != '"' && c == '\''))
+                    return false;
+            }
+            if (part.quote)
+            {
+                arg += value;
+                have = true;
+                continue;
+            }
+
+            // 未加引号的值按空白拆分，与 shell 看到的命令行一致
+            for (QChar c: value)
+            {
+                if (c.isSpace())
+                {
+                    if (have)
+                        out->append(arg);
+                    arg.clear();
+                    have = false;
+                }
+                else
+                {
+                    arg += c;
+                    have = true;
+                }
+            }
+        }
+        if (have)
+            out->append(arg);
+    }
+    return true;
+}
+
+/// quote 为所在的引号，0 为不在引号中
+bool CommandLine::isShellChar(QChar c, char quote)
+{
+    if (c == '\n' || c == '\r')
+        return true;
+#if defined(Q_OS_WIN)
+    if (quote)
+        return c == '%';
+    return QString("&|<>^%()").contains(c);
+#else
+    if (quote == '\'')
+        return false;
+    if (quote == '"')
+        return c == '$' || c == '`' || c == '\\';
+    return QString("|&;<>()$`\\*?[]#~{}!").contains(c);
+#endif
+}
+
+/// 只能由 shell 执行的内部命令、变量赋值
+bool CommandLine::needsShell(const QString &program)
+{
+#if defined(Q_OS_WIN)
+    static const QStringList builtins = {
+        "assoc", "break", "call", "cd", "chdir", "cls", "color", "copy", "date", "del", "dir", "echo",
+        "endlocal", "erase", "for", "ftype", "goto", "if", "md", "mkdir", "mklink", "move", "path",
+        "pause", "popd", "prompt", "pushd", "rd", "ren", "rename", "rmdir", "set", "setlocal", "shift",
+        "start", "time", "title", "type", "ver", "verify", "vol"
+    };
+    return builtins.contains(program, Qt::CaseInsensitive);
+#else
+    static const QStringList builtins = {
+        ".", "alias", "cd", "eval", "exec", "exit", "export", "read", "set", "source",
+        "trap", "ulimit", "umask", "unset", "wait"
+    };
+    return program.contains('=') || builtins.contains(program);
+#endif
+}
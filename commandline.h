@@ -0,0 +1,63 @@
+#ifndef COMMANDLINE_H
+#define COMMANDLINE_H
+
+#include <QStringList>
+#include <QVector>
+
+class QProcess;
+
+/**
+ * 搜索和动作的命令行
+ * 加载模式时拆分成参数列表：没有管道、重定向、变量、通配符等 shell 语法的命令直接启动程序，
+ * 不再多启动一个 /bin/sh（Windows 为 cmd /c）；有这些语法时仍整条交给 shell
+ * %n 在拆分后的参数中替换，拆分结果与替换后交给 shell 相同（未加引号的值按空白拆成多个参数），
+ * 值本身含有 shell 语法时这一条命令改由 shell 执行
+ * 搜索命令末尾的 | grep、| findstr、| head 等由 LinePipeline 在进程内执行，只启动前面的命令
+ */
+class CommandLine
+{
+public:
+    CommandLine() {}
+    explicit CommandLine(const QString& text, bool nativePipes = false); // 拆分模板或完整的命令
+
+    QString text() const { return source; } // 完整的命令行，用于显示和日志
+    bool isEmpty() const { return source.isEmpty(); }
+    bool isDirect() const { return !args.isEmpty(); } // 不经过 shell
+    QString program() const { return args.value(0); }
+    QStringList arguments() const { return args.mid(1); }
+    QList<QStringList> pipeStages() const { return stageArgs; } // 在进程内执行的管道命令
+
+    /// 把 caps 填入 %n，caps[0] 对应 %first
+    CommandLine fill(const QStringList& caps, int first) const;
+
+    void start(QProcess* process) const; // 直接启动程序，或交给 shell；不包含进程内的管道命令
+
+    bool operator==(const CommandLine& other) const { return source == other.source; }
+    bool operator!=(const CommandLine& other) const { return source != other.source; }
+
+private:
+    struct Part
+    {
+        QString text; // 已去掉引号的字面量
+        int cap = -1; // %n 的 n，为 -1 时是字面量
+        char quote = 0; // 所在的引号，0 为不在引号中
+    };
+    typedef QVector<Part> Word;
+
+    void splitPipes();
+    void resolve(const QStringList& caps, int first, CommandLine* out) const;
+    static bool splitWords(const QString& text, QVector<Word>* words);
+    static bool expandWords(const QVector<Word>& words, const QStringList& caps, int first, QStringList* out);
+    static bool isShellChar(QChar c, char quote);
+    static bool needsShell(const QString& program);
+
+private:
+    QString source;
+    QString command; // 去掉进程内管道后要启动的部分
+    QVector<Word> words; // command 拆分后的各个词，需要 shell 时为空
+    QVector<QVector<Word>> stageWords; // 各个进程内管道命令拆分后的词
+    QStringList args; // 填入 %n 后的参数，需要 shell 时为空
+    QList<QStringList> stageArgs;
+};
+
+#endif // COMMANDLINE_H
@@ -0,0 +1,227 @@
+#include <QtConcurrent>
+#include "linematcher.h"
+
+/// resize(0) 不释放已经分配的内存
+void MatchResult::clear()
+{
+    lines.resize(0);
+    beans.resize(0);
+    caps.resize(0);
+    actions.resize(0);
+    actionCaps.resize(0);
+}
+
+LineMatcher::LineMatcher() : pool(new QThreadPool)
+{
+}
+
+LineMatcher::~LineMatcher()
+{
+    pool->waitForDone();
+    delete pool;
+}
+
+void LineMatcher::setMode(const ModeBean &mode)
+{
+    beans = mode.resultLineBeans;
+    prefilter.build(beans);
+    columnCount = mode.captureColumns();
+    chunkBeans.clear();
+}
+
+void LineMatcher::setThreadCount(int count)
+{
+    if (count <= 0)
+        count = QThread::idealThreadCount();
+    pool->setMaxThreadCount(qMax(1, count));
+}
+
+int LineMatcher::threadCount() const
+{
+    return pool->maxThreadCount();
+}
+
+/**
+ * 匹配 store 中 [begin, end) 的输出行，结果依次在 chunkResult(0 .. 返回值-1) 中
+ * 每块的正则副本第一次用到时编译，之后的批次和刷新都直接使用
+ */
+int LineMatcher::match(const ResultStore &store, int begin, int end) const
+{
+    int count = end - begin;
+    int threads = threadCount();
+    if (threads <= 1 || count < minParallelLines)
+    {
+        if (results.isEmpty())
+            results.resize(1);
+        results[0].clear();
+        matchRange(beans, prefilter, columnCount, store, begin, end, results[0]);
+        return 1;
+    }
+
+    // 每个线程一块，块内使用独立编译的正则，互不共享匹配状态
+    int chunkSize = (count + threads - 1) / threads;
+    int chunks = (count + chunkSize - 1) / chunkSize;
+    if (results.size() < chunks)
+        results.resize(chunks);
+    while (chunkBeans.size() < chunks)
+        chunkBeans.append(copyBeans(beans));
+
+    QVector<QFuture<void>> futures;
+    futures.reserve(chunks);
+    const ResultStore* storePtr = &store;
+    const LinePrefilter* prefilterPtr = &prefilter;
+    int columns = columnCount;
+    for (int i = 0; i < chunks; i++)
+    {
+        int chunkBegin = begin + i * chunkSize;
+        int chunkEnd = qMin(chunkBegin + chunkSize, end);
+        const QList<LineBean>* beansPtr = &chunkBeans.at(i);
+        MatchResult* resultPtr = &results[i];
+        resultPtr->clear();
+        futures.append(QtConcurrent::run(pool, [beansPtr, prefilterPtr, columns, storePtr, chunkBegin, chunkEnd, resultPtr] {
+            matchRange(*beansPtr, *prefilterPtr, columns, *storePtr, chunkBegin, chunkEnd, *resultPtr);
+        }));
+    }
+    for (auto& future: futures)
+        future.waitForFinished();
+
+    // 每批的耗时在 SearchTrace 的匹配阶段中统计
+    if (chunks != loggedThreads)
+    {
+        loggedThreads = chunks;
+        qInfo() << "match_threads:" << chunks;
+    }
+    return chunks;
+}
+
+/// 按块的顺序追加，保持原始行序
+void LineMatcher::matchInto(ResultStore &store, int begin, int end) const
+{
+    int chunks = match(store, begin, end);
+    for (int k = 0; k < chunks; k++)
+    {
+        const MatchResult& result = results.at(k);
+        int capPos = 0;
+        for (int i = 0; i < result.lines.size(); i++)
+        {
+            int bean = result.beans.at(i);
+            int capCount = beans.at(bean).actionCapCount;
+            store.appendRow(result.lines.at(i), bean, result.caps.constData() + i * columnCount);
+            store.setRowActions(store.rowCount() - 1, result.actions.at(i), result.actionCaps.constData() + capPos, capCount);
+            capPos += capCount;
+        }
+    }
+}
+
+void LineMatcher::matchActionsInto(ResultStore &store, int beginRow) const
+{
+    QVector<TextSpan> caps;
+    for (int r = beginRow; r < store.rowCount(); r++)
+    {
+        int bean = store.rowBean(r);
+        if (bean < 0 || bean >= beans.size())
+            continue;
+        caps.clear();
+        quint64 actions = matchActions(beans.at(bean), store.rowLineRef(r), caps);
+        store.setRowActions(r, actions, caps.constData(), caps.size());
+    }
+}
+
+/**
+ * 匹配 [begin, end) 范围内的行，追加到 result，捕获组记录为相对 store 文本的偏移
+ * 预筛选排除的 LineBean 一定不匹配，跳过后顺序和结果都与逐个匹配相同
+ */
+void LineMatcher::matchRange(const QList<LineBean> &beans, const LinePrefilter& prefilter, int columnCount,
+                             const ResultStore &store, int begin, int end, MatchResult& result)
+{
+    for (int k = begin; k < end; k++)
+    {
+        QStringRef lineRef = store.lineRef(k);
+        quint64 candidates = prefilter.isEnabled() ? prefilter.candidates(lineRef) : ~quint64(0);
+        if (!candidates) // 不可能匹配任何 LineBean
+            continue;
+
+        // 判断匹配的格式
+        for (int i = 0; i < beans.size(); i++)
+        {
+            if (i < 64 && !(candidates & (quint64(1) << i)))
+                continue;
+            const LineBean& lb = beans.at(i);
+            QRegularExpressionMatch match = lb.regex.match(lineRef);
+            if (!match.hasMatch())
+                continue;
+            if (lb.ignore) // 忽略这一行
+                break;
+
+            result.lines.append(k);
+            result.beans.append(i);
+            for (int j = 0; j < columnCount; j++)
+            {
+                TextSpan span;
+                int start = match.capturedStart(j + 1);
+                if (start >= 0)
+                {
+                    span.start = lineRef.position() + start;
+                    span.length = match.capturedLength(j + 1);
+                }
+                result.caps.append(span);
+            }
+            result.actions.append(matchActions(lb, lineRef, result.actionCaps));
+            break;
+        }
+    }
+}
+
+/**
+ * 行匹配成功后立即判断各动作的 exp，右键菜单只需按位与，不再执行正则
+ * 没有 exp 的动作总是可用；捕获组按 LineBean::actionCapCount 的布局追加到 caps
+ */
+quint64 LineMatcher::matchActions(const LineBean &lb, const QStringRef &lineRef, QVector<TextSpan> &caps)
+{
+    quint64 actions = 0;
+    for (int a = 0; a < lb.actions.size(); a++)
+    {
+        const ActionBean& action = lb.actions.at(a);
+        quint64 bit = a < LineBean::maxActions ? quint64(1) << a : 0;
+        if (action.exp.isEmpty())
+        {
+            actions |= bit;
+            continue;
+        }
+
+        QRegularExpressionMatch match = action.regex.match(lineRef);
+        if (match.hasMatch())
+            actions |= bit;
+        for (int j = 0; j <= action.regex.captureCount(); j++)
+        {
+            TextSpan span;
+            int start = match.hasMatch() ? match.capturedStart(j) : -1;
+            if (start >= 0)
+            {
+                span.start = lineRef.position() + start;
+                span.length = match.capturedLength(j);
+            }
+            caps.append(span);
+        }
+    }
+    return actions;
+}
+
+/// 重新编译每个正则，得到不与其他线程共享的副本
+QList<LineBean> LineMatcher::copyBeans(const QList<LineBean> &beans)
+{
+    QList<LineBean> copies = beans;
+    for (auto& lb: copies)
+    {
+        lb.regex = QRegularExpression(lb.regex.pattern(), lb.regex.patternOptions());
+        lb.regex.optimize();
+        for (auto& action: lb.actions)
+        {
+            if (action.exp.isEmpty())
+                continue;
+            action.regex = QRegularExpression(action.regex.pattern(), action.regex.patternOptions());
+            action.regex.optimize();
+        }
+    }
+    return copies;
+}
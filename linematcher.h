@@ -0,0 +1,66 @@
+#ifndef LINEMATCHER_H
+#define LINEMATCHER_H
+
+#include <QThreadPool>
+#include "modebean.h"
+#include "resultstore.h"
+#include "lineprefilter.h"
+
+/**
+ * 一段输出行的匹配结果
+ * 扁平存放，避免每行一个对象；忽略行和不匹配的行不会出现
+ * 由 LineMatcher 持有并在批次之间复用，清空时保留容量，稳定后每批不再分配内存
+ */
+struct MatchResult
+{
+    QVector<int> lines; // 匹配成功的输出行
+    QVector<int> beans; // 对应的 LineBean 下标
+    QVector<TextSpan> caps; // 捕获组（不含整行），每行固定为列数个
+    QVector<quint64> actions; // 右键菜单可用的动作（按位）
+    QVector<TextSpan> actionCaps; // 动作 exp 的捕获组，每行为对应 LineBean 的 actionCapCount 个
+
+    void clear(); // 保留容量
+};
+
+/**
+ * 把输出行和 LineBean 逐一匹配
+ * 先用 LinePrefilter 一遍扫描出可能匹配的 LineBean，只对这些执行完整的正则
+ * 行数较多时按线程数分块，在线程池中并行匹配，每块使用自己的正则副本，
+ * 结果按原始顺序追加到 store
+ * 正则副本和各块的结果缓冲区在批次之间复用，只能在一个线程中调用 match
+ */
+class LineMatcher
+{
+public:
+    LineMatcher();
+    ~LineMatcher();
+
+    void setMode(const ModeBean& mode);
+    void setThreadCount(int count); // 0 为 CPU 核心数
+    int threadCount() const;
+
+    int match(const ResultStore& store, int begin, int end) const; // 返回结果的块数，按原始顺序
+    const MatchResult& chunkResult(int index) const { return results.at(index); } // 下一次 match 前有效
+    void matchInto(ResultStore& store, int begin, int end) const; // 匹配并追加到 store 的结果行
+    void matchActionsInto(ResultStore& store, int beginRow) const; // 为已经分好列的行（内置数据源）记录动作
+
+    static void matchRange(const QList<LineBean>& beans, const LinePrefilter& prefilter, int columnCount,
+                           const ResultStore& store, int begin, int end, MatchResult& result);
+
+    static quint64 matchActions(const LineBean& lb, const QStringRef& lineRef, QVector<TextSpan>& caps);
+
+private:
+    static QList<LineBean> copyBeans(const QList<LineBean>& beans);
+
+private:
+    QList<LineBean> beans;
+    LinePrefilter prefilter; // 只读，各线程共用
+    int columnCount = 0;
+    QThreadPool* pool;
+    mutable QVector<MatchResult> results; // [块] 上一批的匹配结果
+    mutable QVector<QList<LineBean>> chunkBeans; // [块] 独立编译的正则，模式不变时一直使用
+    mutable int loggedThreads = 0; // 线程数变化时才输出日志，避免每一批都输出
+    static const int minParallelLines = 4096; // 少于这么多行时直接在当前线程匹配
+};
+
+#endif // LINEMATCHER_H
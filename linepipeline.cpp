@@ -0,0 +1,573 @@
+#include <algorithm>
+#include "linepipeline.h"
+
+bool LinePipeline::isStage(const QStringList &argv)
+{
+    Stage stage;
+    return parseStage(argv, &stage);
+}
+
+bool LinePipeline::build(const QList<QStringList> &stages)
+{
+    this->stages.clear();
+    output.clear();
+    hasOutput = false;
+    done = false;
+    for (const QStringList& argv: stages)
+    {
+        Stage stage;
+        if (!parseStage(argv, &stage))
+        {
+            this->stages.clear();
+            return false;
+        }
+        this->stages.append(stage);
+    }
+    return true;
+}
+
+void LinePipeline::push(const QString &text)
+{
+    if (done)
+        return ;
+    for (QStringRef line: text.splitRef('\n'))
+    {
+        if (line.endsWith('\r'))
+            line.chop(1);
+        pushLine(line, 0);
+        if (done)
+            break;
+    }
+}
+
+/// 按顺序输出各个 sort 缓存的行，前面的 sort 输出的行可能进入后面的 sort
+void LinePipeline::finish()
+{
+    for (int i = 0; i < stages.size(); i++)
+        flushStage(i);
+}
+
+bool LinePipeline::takeOutput(QString *text)
+{
+    if (!hasOutput)
+        return false;
+    *text = output;
+    output.clear();
+    hasOutput = false;
+    return true;
+}
+
+/// 一行从第 from 个管道开始依次经过后面的管道，被筛掉或缓存时提前结束
+void LinePipeline::pushLine(QStringRef line, int from)
+{
+    QString cut;
+    for (int i = from; i < stages.size(); i++)
+    {
+        Stage& st = stages[i];
+        Qt::CaseSensitivity cs = st.ignoreCase ? Qt::CaseInsensitive : Qt::CaseSensitive;
+        switch (st.type)
+        {
+        case Stage::Grep:
+        {
+            bool found = false;
+            if (st.regex.pattern().isEmpty())
+            {
+                for (const QString& literal: st.literals)
+                    if ((found = line.contains(literal, cs)))
+                        break;
+            }
+            else
+            {
+                found = st.regex.match(line).hasMatch();
+            }
+            if (found == st.invert)
+                return ;
+            break;
+        }
+        case Stage::Head:
+            if (st.count >= st.limit)
+            {
+                done = true;
+                return ;
+            }
+            if (++st.count >= st.limit)
+                done = true; // 与关闭管道一样，不再需要搜索命令之后的输出
+            break;
+        case Stage::Sort:
+            st.buffer.append(line.toString());
+            return ;
+        case Stage::Uniq:
+            if (st.hasLast && st.last.compare(line, cs) == 0)
+                return ;
+            st.last = line.toString();
+            st.hasLast = true;
+            break;
+        case Stage::Cut:
+        {
+            QString text;
+            if (!cutLine(st, line, &text))
+                return ;
+            cut = text;
+            line = QStringRef(&cut);
+            break;
+        }
+        }
+    }
+
+    if (hasOutput)
+        output += '\n';
+    output += line;
+    hasOutput = true;
+}
+
+/**
+ * 与 sort 相同：按键比较，键相同时再比较整行（-s 时保持原顺序），-r 时全部反过来
+ * 文本按字符编码比较，相当于 LC_ALL=C
+ */
+void LinePipeline::flushStage(int index)
+{
+    Stage& st = stages[index];
+    if (st.type != Stage::Sort || st.buffer.isEmpty())
+        return ;
+    const QStringList lines = st.buffer;
+    st.buffer.clear();
+
+    struct Item
+    {
+        QStringRef key;
+        double number;
+        int index;
+    };
+    QVector<Item> items(lines.size());
+    for (int i = 0; i < lines.size(); i++)
+    {
+        items[i].key = sortKey(st, lines.at(i));
+        items[i].number = st.numeric ? leadingNumber(items[i].key) : 0;
+        items[i].index = i;
+    }
+
+    Qt::CaseSensitivity cs = st.ignoreCase ? Qt::CaseInsensitive : Qt::CaseSensitive;
+    auto compareKeys = [&](const Item& a, const Item& b) {
+        if (st.numeric)
+            return a.number < b.number ? -1 : a.number > b.number ? 1 : 0;
+        return a.key.compare(b.key, cs);
+    };
+    std::stable_sort(items.begin(), items.end(), [&](const Item& a, const Item& b) {
+        int cmp = compareKeys(a, b);
+        if (!cmp && !st.stable)
+            cmp = lines.at(a.index).compare(lines.at(b.index));
+        return st.reverse ? cmp > 0 : cmp < 0;
+    });
+
+    for (int i = 0; i < items.size(); i++)
+    {
+        if (st.unique && i > 0 && compareKeys(items.at(i - 1), items.at(i)) == 0)
+            continue;
+        pushLine(QStringRef(&lines.at(items.at(i).index)), index + 1);
+    }
+}
+
+/// -k 的起止字段；不指定 -t 时每个字段包含它前面的空白，与 sort 一致
+QStringRef LinePipeline::sortKey(const Stage &stage, const QString &line)
+{
+    if (stage.keyStart <= 0)
+        return QStringRef(&line);
+
+    int start = -1, end = line.size();
+    int pos = 0;
+    for (int field = 1; pos <= line.size(); field++)
+    {
+        int fieldStart = pos;
+        if (stage.separator.isNull())
+        {
+            while (pos < line.size() && line.at(pos).isSpace())
+                pos++;
+            while (pos < line.size() && !line.at(pos).isSpace())
+                pos++;
+        }
+        else
+        {
+            while (pos < line.size() && line.at(pos) != stage.separator)
+                pos++;
+        }
+        if (field == stage.keyStart)
+            start = fieldStart;
+        if (field == stage.keyEnd)
+        {
+            end = pos;
+            break;
+        }
+        if (pos >= line.size())
+            break;
+        if (!stage.separator.isNull())
+            pos++; // 跳过分隔符
+    }
+    if (start < 0)
+        return QStringRef();
+    return line.midRef(start, qMax(0, end - start));
+}
+
+/// 开头的数字，跳过前面的空白；没有数字时为 0
+double LinePipeline::leadingNumber(const QStringRef &text)
+{
+    int pos = 0;
+    while (pos < text.size() && text.at(pos).isSpace())
+        pos++;
+    int start = pos;
+    if (pos < text.size() && text.at(pos) == '-')
+        pos++;
+    while (pos < text.size() && text.at(pos).isDigit())
+        pos++;
+    if (pos < text.size() && text.at(pos) == '.')
+    {
+        pos++;
+        while (pos < text.size() && text.at(pos).isDigit())
+            pos++;
+    }
+    bool ok = false;
+    double value = text.mid(start, pos - start).toDouble(&ok);
+    return ok ? value : 0;
+}
+
+/// 按字段或字符取出列表中的部分，保持原来的顺序；-s 时没有分隔符的行丢弃
+bool LinePipeline::cutLine(const Stage &stage, const QStringRef &line, QString *out)
+{
+    auto selected = [&](int n) {
+        for (const auto& range: stage.ranges)
+            if (n >= range.first && (range.second == 0 || n <= range.second))
+                return true;
+        return false;
+    };
+
+    out->clear();
+    if (stage.byChars)
+    {
+        for (int i = 0; i < line.size(); i++)
+            if (selected(i + 1))
+                out->append(line.at(i));
+        return true;
+    }
+
+    if (!line.contains(stage.separator))
+    {
+        if (stage.onlyDelimited)
+            return false;
+        *out = line.toString();
+        return true;
+    }
+    bool first = true;
+    int field = 1;
+    int start = 0;
+    while (start <= line.size())
+    {
+        int end = line.indexOf(stage.separator, start);
+        if (end < 0)
+            end = line.size();
+        if (selected(field++))
+        {
+            if (!first)
+                out->append(stage.separator);
+            out->append(line.mid(start, end - start));
+            first = false;
+        }
+        start = end + 1;
+    }
+    return true;
+}
+
+bool LinePipeline::parseStage(const QStringList &argv, Stage *stage)
+{
+    QString program = argv.value(0);
+    if (program == "grep")
+        return parseGrep(argv, stage);
+    if (program.compare("findstr", Qt::CaseInsensitive) == 0)
+        return parseFindstr(argv, stage);
+    if (program == "head")
+        return parseHead(argv, stage);
+    if (program == "sort")
+        return parseSort(argv, stage);
+    if (program == "uniq")
+        return parseUniq(argv, stage);
+    if (program == "cut")
+        return parseCut(argv, stage);
+    return false;
+}
+
+/**
+ * grep [-viFEG] pattern
+ * 基本正则（默认）中 + ? ( ) { } | 为普通字符，转义后交给 QRegularExpression；含反斜杠时不支持
+ */
+bool LinePipeline::parseGrep(const QStringList &argv, Stage *stage)
+{
+    stage->type = Stage::Grep;
+    bool fixed = false, extended = false, options = true;
+    QStringList patterns;
+    for (int i = 1; i < argv.size(); i++)
+    {
+        const QString& arg = argv.at(i);
+        if (options && arg == "--")
+        {
+            options = false;
+            continue;
+        }
+        if (options && arg.size() > 1 && arg.startsWith('-'))
+        {
+            for (QChar c: arg.mid(1))
+            {
+                if (c == 'v')
+                    stage->invert = true;
+                else if (c == 'i')
+                    stage->ignoreCase = true;
+                else if (c == 'F')
+                    fixed = true;
+                else if (c == 'E')
+                    extended = true;
+                else if (c == 'G')
+                    extended = false;
+                else
+                    return false;
+            }
+            continue;
+        }
+        patterns.append(arg);
+    }
+    if (patterns.size() != 1) // 没有表达式，或者后面是文件名
+        return false;
+
+    QString pattern = patterns.first();
+    const QString special = extended ? ".[]*^$+?(){}|" : ".[]*^$";
+    bool literal = fixed;
+    if (!fixed)
+    {
+        if (pattern.contains('\\'))
+            return false;
+        literal = std::none_of(pattern.begin(), pattern.end(), [&](QChar c) { return special.contains(c); });
+    }
+    if (literal)
+    {
+        stage->literals = QStringList{pattern};
+        return true;
+    }
+
+    QString exp;
+    for (QChar c: pattern)
+    {
+        if (!extended && QString("+?(){}|").contains(c))
+            exp += '\\';
+        exp += c;
+    }
+    stage->regex = QRegularExpression(exp, stage->ignoreCase ? QRegularExpression::CaseInsensitiveOption
+                                                              : QRegularExpression::NoPatternOption);
+    if (!stage->regex.isValid())
+        return false;
+    stage->regex.optimize();
+    return true;
+}
+
+/**
+ * findstr [/I] [/V] [/L] "a b"
+ * 以空格分隔的多个字符串任一出现即匹配；含有正则字符且没有 /L 时不支持
+ */
+bool LinePipeline::parseFindstr(const QStringList &argv, Stage *stage)
+{
+    stage->type = Stage::Grep;
+    bool literal = false;
+    QStringList patterns;
+    for (int i = 1; i < argv.size(); i++)
+    {
+        const QString& arg = argv.at(i);
+        if (arg.size() == 2 && (arg.startsWith('/') || arg.startsWith('-')))
+        {
+            QChar c = arg.at(1).toUpper();
+            if (c == 'I')
+                stage->ignoreCase = true;
+            else if (c == 'V')
+                stage->invert = true;
+            else if (c == 'L')
+                literal = true;
+            else
+                return false;
+            continue;
+        }
+        patterns.append(arg);
+    }
+    if (patterns.size() != 1)
+        return false;
+
+    stage->literals = patterns.first().split(' ', QString::SkipEmptyParts);
+    if (stage->literals.isEmpty())
+        return false;
+    if (!literal)
+    {
+        for (const QString& s: stage->literals)
+            for (QChar c: s)
+                if (QString(".*^$[]\\").contains(c))
+                    return false;
+    }
+    return true;
+}
+
+/// head、head -n N、head -nN、head -N
+bool LinePipeline::parseHead(const QStringList &argv, Stage *stage)
+{
+    stage->type = Stage::Head;
+    for (int i = 1; i < argv.size(); i++)
+    {
+        QString arg = argv.at(i);
+        QString value;
+        if (arg == "-n" && i + 1 < argv.size())
+            value = argv.at(++i);
+        else if (arg.startsWith("-n"))
+            value = arg.mid(2);
+        else if (arg.startsWith('-'))
+            value = arg.mid(1);
+        else
+            return false;
+        bool ok = false;
+        stage->limit = value.toLongLong(&ok);
+        if (!ok || stage->limit < 0 || value.startsWith('-') || value.startsWith('+'))
+            return false;
+    }
+    return true;
+}
+
+/// sort [-nrfsu] [-k N[,M]] [-t C]
+bool LinePipeline::parseSort(const QStringList &argv, Stage *stage)
+{
+    stage->type = Stage::Sort;
+    bool hasKey = false;
+    for (int i = 1; i < argv.size(); i++)
+    {
+        const QString& arg = argv.at(i);
+        if (arg.size() < 2 || !arg.startsWith('-'))
+            return false;
+        for (int j = 1; j < arg.size(); j++)
+        {
+            QChar c = arg.at(j);
+            if (c == 'k' || c == 't')
+            {
+                QString value = arg.mid(j + 1);
+                if (value.isEmpty())
+                {
+                    if (i + 1 >= argv.size())
+                        return false;
+                    value = argv.at(++i);
+                }
+                if (c == 't')
+                {
+                    if (value.size() != 1)
+                        return false;
+                    stage->separator = value.at(0);
+                    break;
+                }
+                if (hasKey)
+                    return false; // 只支持一个 -k
+                hasKey = true;
+                QStringList pos = value.split(',');
+                bool ok = false, okEnd = true;
+                stage->keyStart = pos.at(0).toInt(&ok);
+                if (pos.size() > 1)
+                    stage->keyEnd = pos.at(1).toInt(&okEnd);
+                if (!ok || !okEnd || pos.size() > 2 || stage->keyStart < 1
+                        || (pos.size() > 1 && stage->keyEnd < stage->keyStart))
+                    return false;
+                break;
+            }
+            if (c == 'n')
+                stage->numeric = true;
+            else if (c == 'r')
+                stage->reverse = true;
+            else if (c == 'f')
+                stage->ignoreCase = true;
+            else if (c == 's')
+                stage->stable = true;
+            else if (c == 'u')
+                stage->unique = true;
+            else
+                return false;
+        }
+    }
+    return true;
+}
+
+/// uniq、uniq -i
+bool LinePipeline::parseUniq(const QStringList &argv, Stage *stage)
+{
+    stage->type = Stage::Uniq;
+    for (int i = 1; i < argv.size(); i++)
+    {
+        if (argv.at(i) != "-i")
+            return false;
+        stage->ignoreCase = true;
+    }
+    return true;
+}
+
+/// cut -f LIST [-d C] [-s]、cut -c LIST
+bool LinePipeline::parseCut(const QStringList &argv, Stage *stage)
+{
+    stage->type = Stage::Cut;
+    stage->separator = '\t';
+    QString list;
+    bool fields = false;
+    for (int i = 1; i < argv.size(); i++)
+    {
+        const QString& arg = argv.at(i);
+        if (arg == "-s")
+        {
+            stage->onlyDelimited = true;
+            continue;
+        }
+        if (arg.size() < 2 || !arg.startsWith('-') || !QString("dfc").contains(arg.at(1)))
+            return false;
+        QChar c = arg.at(1);
+        QString value = arg.mid(2);
+        if (value.isEmpty())
+        {
+            if (i + 1 >= argv.size())
+                return false;
+            value = argv.at(++i);
+        }
+        if (c == 'd')
+        {
+            if (value.size() != 1)
+                return false;
+            stage->separator = value.at(0);
+        }
+        else
+        {
+            if (!list.isEmpty())
+                return false;
+            list = value;
+            fields = (c == 'f');
+            stage->byChars = (c == 'c');
+        }
+    }
+    if (list.isEmpty() || (stage->onlyDelimited && !fields))
+        return false;
+    return parseRanges(list, &stage->ranges);
+}
+
+/// 1,3-5,7-,-2
+bool LinePipeline::parseRanges(const QString &list, QVector<QPair<int, int>> *ranges)
+{
+    for (const QString& part: list.split(','))
+    {
+        int dash = part.indexOf('-');
+        bool ok1 = true, ok2 = true;
+        int from, to;
+        if (dash < 0)
+        {
+            from = to = part.toInt(&ok1);
+        }
+        else
+        {
+            from = dash == 0 ? 1 : part.left(dash).toInt(&ok1);
+            to = dash == part.size() - 1 ? 0 : part.mid(dash + 1).toInt(&ok2);
+        }
+        if (!ok1 || !ok2 || from < 1 || (to && to < from) || (dash == 0 && !to))
+            return false;
+        ranges->append(qMakePair(from, to));
+    }
+    return !ranges->isEmpty();
+}
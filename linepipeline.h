@@ -0,0 +1,84 @@
+#ifndef LINEPIPELINE_H
+#define LINEPIPELINE_H
+
+#include <QStringList>
+#include <QRegularExpression>
+#include <QVector>
+#include <QPair>
+
+/**
+ * 进程内执行的管道命令
+ * search_exp 末尾的 | grep、| findstr、| head、| sort、| uniq、| cut 不再启动进程，
+ * 在搜索命令的输出上逐批执行，Windows 和 Linux 上的结果相同
+ * 只支持常用的选项，不认识的写法仍交给 shell，不会得到与 shell 不同的结果
+ */
+class LinePipeline
+{
+public:
+    static bool isStage(const QStringList& argv); // argv 是否可以在进程内执行
+
+    bool build(const QList<QStringList>& stages);
+    bool isEmpty() const { return stages.isEmpty(); }
+    void push(const QString& text); // 一批完整的行，不含最后的换行符
+    void finish(); // 命令结束，输出 sort 等缓存的行
+    bool takeOutput(QString* text); // 取出已经通过所有管道的行，没有时返回 false
+    bool isDone() const { return done; } // head 已经读够，之后的输出都会被丢弃
+
+private:
+    struct Stage
+    {
+        enum Type
+        {
+            Grep,
+            Head,
+            Sort,
+            Uniq,
+            Cut
+        };
+        Type type = Grep;
+        bool invert = false; // grep -v
+        bool ignoreCase = false; // grep -i、sort -f、uniq -i
+        QStringList literals; // 任一出现即匹配，regex 无效时使用
+        QRegularExpression regex;
+        qint64 limit = 10; // head -n
+        bool numeric = false; // sort -n
+        bool reverse = false; // sort -r
+        bool stable = false; // sort -s
+        bool unique = false; // sort -u
+        int keyStart = 0; // sort -k 的起止字段（从 1 开始），0 为整行
+        int keyEnd = 0;
+        QChar separator; // sort -t、cut -d，为空时按空白分隔
+        bool byChars = false; // cut -c
+        bool onlyDelimited = false; // cut -s
+        QVector<QPair<int, int>> ranges; // cut 的列表，从 1 开始，0 为不限
+
+        // 执行时的状态
+        qint64 count = 0;
+        QStringList buffer; // sort 缓存的行
+        QString last; // uniq 的上一行
+        bool hasLast = false;
+    };
+
+    static bool parseStage(const QStringList& argv, Stage* stage);
+    static bool parseGrep(const QStringList& argv, Stage* stage);
+    static bool parseFindstr(const QStringList& argv, Stage* stage);
+    static bool parseHead(const QStringList& argv, Stage* stage);
+    static bool parseSort(const QStringList& argv, Stage* stage);
+    static bool parseUniq(const QStringList& argv, Stage* stage);
+    static bool parseCut(const QStringList& argv, Stage* stage);
+    static bool parseRanges(const QString& list, QVector<QPair<int, int>>* ranges);
+
+    void pushLine(QStringRef line, int from);
+    void flushStage(int index);
+    static QStringRef sortKey(const Stage& stage, const QString& line);
+    static double leadingNumber(const QStringRef& text);
+    static bool cutLine(const Stage& stage, const QStringRef& line, QString* out);
+
+private:
+    QVector<Stage> stages;
+    QString output;
+    bool hasOutput = false;
+    bool done = false;
+};
+
+#endif // LINEPIPELINE_H
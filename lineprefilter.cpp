@@ -0,0 +1,261 @@
+#include <cstring>
+#include <QQueue>
+#include <QDebug>
+#include "lineprefilter.h"
+
+void LinePrefilter::build(const QList<LineBean> &beans)
+{
+    enabled = false;
+    always = all = 0;
+    memset(asciiClasses, 0, sizeof(asciiClasses));
+    otherClasses.clear();
+    classCount = 1;
+    transitions.clear();
+    outputs.clear();
+    if (beans.isEmpty() || beans.size() > 64)
+        return ;
+
+    QStringList literals;
+    for (int i = 0; i < beans.size(); i++)
+    {
+        const LineBean& lb = beans.at(i);
+        QString literal = requiredLiteral(lb.regex.pattern(), lb.regex.patternOptions());
+        literals.append(literal);
+        all |= quint64(1) << i;
+        if (literal.isEmpty())
+            always |= quint64(1) << i;
+        for (QChar c: literal)
+        {
+            ushort u = c.unicode();
+            if (charClass(u))
+                continue;
+            if (u < 128)
+                asciiClasses[u] = classCount++;
+            else
+                otherClasses.insert(u, classCount++);
+        }
+    }
+    if (always == all)
+        return ;
+
+    // 字典树，-1 为还没有边
+    QVector<QVector<int>> trie(1, QVector<int>(classCount, -1));
+    outputs = QVector<quint64>(1, 0);
+    for (int i = 0; i < literals.size(); i++)
+    {
+        int state = 0;
+        for (QChar c: literals.at(i))
+        {
+            int cls = charClass(c.unicode());
+            if (trie[state][cls] < 0)
+            {
+                trie[state][cls] = trie.size();
+                trie.append(QVector<int>(classCount, -1));
+                outputs.append(0);
+            }
+            state = trie[state][cls];
+        }
+        if (!literals.at(i).isEmpty())
+            outputs[state] |= quint64(1) << i;
+    }
+
+    // 按层遍历补全失败转移，每个状态的输出合并其失败状态的输出
+    QVector<int> fail(trie.size(), 0);
+    QQueue<int> queue;
+    for (int c = 0; c < classCount; c++)
+    {
+        int s = trie[0][c];
+        if (s < 0)
+            trie[0][c] = 0;
+        else
+            queue.enqueue(s);
+    }
+    while (!queue.isEmpty())
+    {
+        int r = queue.dequeue();
+        outputs[r] |= outputs[fail[r]];
+        for (int c = 0; c < classCount; c++)
+        {
+            int s = trie[r][c];
+            if (s < 0)
+            {
+                trie[r][c] = trie[fail[r]][c];
+                continue;
+            }
+            fail[s] = trie[fail[r]][c];
+            queue.enqueue(s);
+        }
+    }
+
+    transitions.resize(trie.size() * classCount);
+    for (int s = 0; s < trie.size(); s++)
+        for (int c = 0; c < classCount; c++)
+            transitions[s * classCount + c] = trie[s][c];
+    enabled = true;
+    if (literals != loggedLiterals)
+    {
+        loggedLiterals = literals;
+        qInfo() << "prefilter_literals:" << literals << "states:" << trie.size();
+    }
+}
+
+quint64 LinePrefilter::candidates(const QStringRef &line) const
+{
+    quint64 found = always;
+    const QChar* data = line.constData();
+    const int* table = transitions.constData();
+    const quint64* out = outputs.constData();
+    int state = 0;
+    for (int i = 0; i < line.size(); i++)
+    {
+        state = table[state * classCount + charClass(data[i].unicode())];
+        found |= out[state];
+        if (found == all)
+            break;
+    }
+    return found;
+}
+
+/**
+ * 提取 pattern 的每个匹配中一定出现的最长一段字面量，不能确定时返回空
+ * 只看顶层：分组和字符类整体跳过，可省略的字符（后跟 ?、*、{）不计入，
+ * 顶层有 | 或可能忽略大小写时放弃；宁可找不到，也不能找错
+ */
+QString LinePrefilter::requiredLiteral(const QString &pattern, QRegularExpression::PatternOptions options)
+{
+    if (options & (QRegularExpression::CaseInsensitiveOption | QRegularExpression::ExtendedPatternSyntaxOption))
+        return QString();
+
+    const int n = pattern.size();
+    QString best, run;
+    auto flush = [&] {
+        if (run.size() > best.size())
+            best = run;
+        run.clear();
+    };
+    auto at = [&](int i) { return i < n ? pattern.at(i) : QChar(); };
+
+    // 跳过字符类，返回 ']' 的位置
+    auto skipClass = [&](int i) {
+        i++;
+        if (at(i) == '^')
+            i++;
+        if (at(i) == ']')
+            i++;
+        while (i < n && pattern.at(i) != ']')
+        {
+            if (pattern.at(i) == '\\')
+                i++;
+            else if (pattern.at(i) == '[' && at(i + 1) == ':')
+            {
+                int end = pattern.indexOf(":]", i + 2);
+                if (end >= 0)
+                    i = end + 1;
+            }
+            i++;
+        }
+        return i;
+    };
+
+    // 跳过转义，返回转义的最后一个字符；literal 为转义表示的字面量，不是字面量时为空
+    auto skipEscape = [&](int i, QChar* literal) {
+        QChar e = at(i + 1);
+        *literal = QChar();
+        i++;
+        if (e.isNull())
+            return i;
+        if (!e.isLetterOrNumber())
+        {
+            *literal = e;
+            return i;
+        }
+        if (e == 'c')
+            return i + 1;
+        if (QString("kgpPNxo").contains(e) && QString("{<'").contains(at(i + 1)))
+        {
+            QChar close = at(i + 1) == '{' ? QChar('}') : at(i + 1) == '<' ? QChar('>') : QChar('\'');
+            int end = pattern.indexOf(close, i + 2);
+            return end < 0 ? n : end;
+        }
+        if (e == 'x' || e == 'o' || e.isDigit())
+        {
+            while (i + 1 < n && QString("0123456789abcdefABCDEF").contains(pattern.at(i + 1)))
+                i++;
+        }
+        return i;
+    };
+
+    int depth = 0;
+    for (int i = 0; i < n; i++)
+    {
+        QChar c = pattern.at(i);
+        if (c == '\\' && at(i + 1) == 'Q')
+            return QString();
+        if (c == '(' && at(i + 1) == '?' && QString("imsxnJUX-^").contains(at(i + 2)))
+            return QString(); // 内联选项可能改变大小写或空白的含义
+
+        if (depth > 0)
+        {
+            QChar literal;
+            if (c == '\\')
+                i = skipEscape(i, &literal);
+            else if (c == '[')
+                i = skipClass(i);
+            else if (c == '(')
+                depth++;
+            else if (c == ')')
+                depth--;
+            continue;
+        }
+
+        QChar literal;
+        if (c == '|')
+            return QString();
+        if (c == '(')
+        {
+            flush();
+            depth = 1;
+            continue;
+        }
+        if (c == '[')
+        {
+            flush();
+            i = skipClass(i);
+            continue;
+        }
+        if (c == '{')
+        {
+            flush();
+            int end = pattern.indexOf('}', i);
+            i = end < 0 ? n : end;
+            continue;
+        }
+        if (c == '*' || c == '+' || c == '?' || c == '.' || c == '^' || c == '$' || c == ')')
+        {
+            flush();
+            continue;
+        }
+        if (c == '\\')
+            i = skipEscape(i, &literal);
+        else
+            literal = c;
+        if (literal.isNull())
+        {
+            flush();
+            continue;
+        }
+
+        // 量词作用于这一个字符
+        QChar q = at(i + 1);
+        if (q == '?' || q == '*' || q == '{')
+        {
+            flush();
+            continue;
+        }
+        run += literal;
+        if (q == '+')
+            flush();
+    }
+    flush();
+    return best;
+}
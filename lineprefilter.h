@@ -0,0 +1,43 @@
+#ifndef LINEPREFILTER_H
+#define LINEPREFILTER_H
+
+#include <QHash>
+#include <QVector>
+#include <QStringRef>
+#include "modebean.h"
+
+/**
+ * 行匹配前的预筛选
+ * 加载模式时从每个 LineBean 的 expression 中提取一定会出现的字面量，合成一个 Aho-Corasick 自动机；
+ * 每行只扫描一遍，就知道哪些 LineBean 可能匹配，之后只按顺序执行这些 LineBean 的完整正则。
+ * 一个字面量都不包含的行（噪声输出中的大多数）不再执行任何正则，ignore 的行也在这一遍中排除
+ * 提取不出字面量的 expression（顶层有 |、忽略大小写等）总是候选，结果与逐个匹配完全相同
+ */
+class LinePrefilter
+{
+public:
+    void build(const QList<LineBean>& beans);
+    bool isEnabled() const { return enabled; }
+    quint64 candidates(const QStringRef& line) const; // 可能匹配这一行的 LineBean（按位，低位在前）
+
+    static QString requiredLiteral(const QString& pattern, QRegularExpression::PatternOptions options);
+
+private:
+    int charClass(ushort c) const
+    {
+        return c < 128 ? asciiClasses[c] : otherClasses.value(c, 0);
+    }
+
+private:
+    bool enabled = false;
+    quint64 always = 0; // 没有字面量的 LineBean
+    quint64 all = 0; // 全部 LineBean，都找到后提前结束扫描
+    int asciiClasses[128] = {}; // 字符 -> 字符类，0 为不在任何字面量中
+    QHash<ushort, int> otherClasses;
+    int classCount = 1;
+    QVector<int> transitions; // [状态 * classCount + 字符类] -> 下一个状态，已合并失败转移
+    QVector<quint64> outputs; // [状态] 到达时已经出现的字面量对应的 LineBean
+    QStringList loggedLiterals; // 重新加载同样的模式时不再重复输出日志
+};
+
+#endif // LINEPREFILTER_H
@@ -0,0 +1,320 @@
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDateTime>
+#include <QSaveFile>
+#include <QCryptographicHash>
+#include <QTextCodec>
+#include <QEventLoop>
+#include "listhuntercore.h"
+#include "linematcher.h"
+#include "searchrunner.h"
+#include "nativesource.h"
+
+static const quint32 modeCacheMagic = 0x4C484D43; // "LHMC"
+static const quint32 modeCacheVersion = 3; // ModeBean::toStream 的格式变化时增加
+
+ListHunterCore::ListHunterCore() : lineMatcher(new LineMatcher)
+{
+}
+
+ListHunterCore::~ListHunterCore()
+{
+    delete lineMatcher;
+}
+
+/// 与 readTextFileAutoCodec 相同的判断，fileutil 依赖 QtWidgets，这里不使用
+bool ListHunterCore::readModeFile(const QString &path, MyJson *json, QString *error)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        if (error)
+            *error = "无法打开文件：" + path;
+        return false;
+    }
+    return parseModeJson(file.readAll(), json, error);
+}
+
+bool ListHunterCore::parseModeJson(const QByteArray &bytes, MyJson *json, QString *error)
+{
+    QByteArray ba = bytes;
+    QTextCodec::ConverterState state;
+    QTextCodec::codecForName("UTF-8")->toUnicode(ba.constData(), ba.size(), &state);
+    if (state.invalidChars > 0)
+        ba = QTextCodec::codecForName("GBK")->toUnicode(ba).toUtf8();
+
+    bool ok;
+    *json = MyJson::from(ba, &ok, error);
+    return ok;
+}
+
+bool ListHunterCore::loadModeFile(const QString &path, QStringList *errors)
+{
+    MyJson json;
+    QString error;
+    if (!readModeFile(path, &json, &error))
+    {
+        if (errors)
+            errors->append(error);
+        return false;
+    }
+    return loadMode(json, errors);
+}
+
+bool ListHunterCore::loadMode(const MyJson &json, QStringList *errors)
+{
+    QStringList errs;
+    ModeBean mode = ModeBean::fromJson(json, &errs);
+    if (!errs.isEmpty())
+    {
+        if (errors)
+            *errors += errs;
+        return false;
+    }
+    setMode(mode);
+    return true;
+}
+
+void ListHunterCore::setMode(const ModeBean &mode)
+{
+    m = mode;
+    lineMatcher->setMode(m);
+}
+
+/**
+ * 优先从缓存加载模式文件
+ * 缓存以模式文件的绝对路径命名，头部记录 JSON 的修改时间、大小和内容哈希：
+ * 修改时间和大小都没变时只读一次缓存文件，直接反序列化（正则仍需编译）；
+ * 否则读取 JSON 计算哈希，内容没变时沿用缓存，变了才重新解析并写入缓存
+ */
+bool ListHunterCore::loadModeFileCached(const QString &path, const QString &cacheDir, QStringList *errors, bool *fromCache)
+{
+    if (fromCache)
+        *fromCache = false;
+    QFileInfo info(path);
+    QString absPath = info.absoluteFilePath();
+    qint64 mtime = info.lastModified().toMSecsSinceEpoch();
+    qint64 size = info.size();
+    QString cachePath = modeCachePath(cacheDir, absPath);
+
+    QByteArray cached;
+    QFile cache(cachePath);
+    if (cache.open(QIODevice::ReadOnly))
+        cached = cache.readAll();
+    QDataStream in(cached);
+    in.setVersion(QDataStream::Qt_5_0);
+    quint32 magic = 0, version = 0;
+    QString cachedPath;
+    qint64 cachedMtime = 0, cachedSize = -1;
+    QByteArray cachedHash;
+    if (!cached.isEmpty())
+        in >> magic >> version >> cachedPath >> cachedMtime >> cachedSize >> cachedHash;
+    bool header = in.status() == QDataStream::Ok && magic == modeCacheMagic
+            && version == modeCacheVersion && cachedPath == absPath;
+
+    if (header && cachedMtime == mtime && cachedSize == size)
+    {
+        ModeBean mode = ModeBean::fromStream(in);
+        if (in.status() == QDataStream::Ok)
+        {
+            setMode(mode);
+            if (fromCache)
+                *fromCache = true;
+            return true;
+        }
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        if (errors)
+            errors->append("无法打开文件：" + path);
+        return false;
+    }
+    QByteArray bytes = file.readAll();
+    QByteArray hash = QCryptographicHash::hash(bytes, QCryptographicHash::Sha1);
+
+    // 只是修改时间变了
+    if (header && hash == cachedHash)
+    {
+        ModeBean mode = ModeBean::fromStream(in);
+        if (in.status() == QDataStream::Ok)
+        {
+            setMode(mode);
+            writeModeCache(cachePath, absPath, mtime, size, hash, mode);
+            if (fromCache)
+                *fromCache = true;
+            return true;
+        }
+    }
+
+    MyJson json;
+    QString error;
+    if (!parseModeJson(bytes, &json, &error))
+    {
+        if (errors)
+            errors->append(error);
+        return false;
+    }
+    if (!loadMode(json, errors))
+        return false;
+    writeModeCache(cachePath, absPath, mtime, size, hash, m);
+    return true;
+}
+
+QString ListHunterCore::modeCachePath(const QString &cacheDir, const QString &path)
+{
+    QByteArray name = QCryptographicHash::hash(path.toUtf8(), QCryptographicHash::Sha1).toHex();
+    return QDir(cacheDir).filePath(QString::fromLatin1(name) + ".bin");
+}
+
+void ListHunterCore::writeModeCache(const QString &cachePath, const QString &path, qint64 mtime, qint64 size,
+                                    const QByteArray &hash, const ModeBean &mode)
+{
+    QDir().mkpath(QFileInfo(cachePath).absolutePath());
+    QSaveFile file(cachePath);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qWarning() << "无法写入模式缓存：" << cachePath;
+        return ;
+    }
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_0);
+    out << modeCacheMagic << modeCacheVersion << path << mtime << size << hash;
+    mode.toStream(out);
+    if (!file.commit())
+        qWarning() << "无法写入模式缓存：" << cachePath;
+}
+
+/**
+ * 与界面相同的搜索流程：内置数据源直接读取；否则执行 search_types 中的命令，
+ * 输出分批匹配；key_filter 模式执行基础命令后在结果上筛选
+ * 流式搜索没有结束的时候，每批新行交给 rowsReady
+ */
+bool ListHunterCore::search(const QString &key, ResultStore &store, QString *error, const RowsCallback &rowsReady) const
+{
+    store.reset(m.captureColumns());
+    if (!m.source.isEmpty())
+    {
+        bool ok = NativeSource::read(m.source, key, store, error);
+        lineMatcher->matchActionsInto(store, 0);
+        store.spillIfNeeded();
+        return ok;
+    }
+
+    bool filter = m.keyFilter != ModeBean::NoKeyFilter;
+    bool stream = false;
+    CommandLine cmd = m.searchCmd(filter ? "" : key, &stream);
+    if (cmd.isEmpty())
+    {
+        if (error)
+            *error = "search_types 下没有满足关键词的搜索表达式";
+        return false;
+    }
+    if (stream && !rowsReady)
+    {
+        if (error)
+            *error = "流式搜索的命令不会结束，需要逐批接收结果";
+        return false;
+    }
+
+    SearchRunner runner;
+    QEventLoop loop;
+    bool ok = false;
+    QObject::connect(&runner, &SearchRunner::outputReady, [&](quint64, const QString& text) {
+        int firstRow = store.rowCount();
+        int first = store.appendText(text);
+        lineMatcher->matchInto(store, first, store.lineCount());
+        if (!stream)
+        {
+            store.spillIfNeeded();
+            return ;
+        }
+        // 流式命令一直运行到被中断，新行先交给调用方，再只保留最新的 stream_max_rows 行
+        if (store.rowCount() > firstRow)
+            rowsReady(store, firstRow);
+        if (m.streamMaxRows > 0 && store.rowCount() > m.streamMaxRows)
+            store.removeFirstRows(store.rowCount() - m.streamMaxRows);
+        store.compact();
+    });
+    QObject::connect(&runner, &SearchRunner::finished, [&](quint64, bool success, const QString& err) {
+        ok = success;
+        if (error)
+            *error = err;
+        loop.quit();
+    });
+    qInfo() << "exec_cmd:" << cmd.text() << "direct:" << cmd.isDirect();
+    runner.start(cmd, stream ? 0 : m.timeoutMs);
+    loop.exec();
+
+    if (filter && !key.isEmpty())
+    {
+        QVector<int> rows;
+        if (m.keyFilter == ModeBean::RegexKeyFilter)
+        {
+            QRegularExpression re(key);
+            if (!re.isValid())
+            {
+                if (error)
+                    *error = "关键词不是有效的正则表达式：" + re.errorString();
+                return false;
+            }
+            re.optimize();
+            rows = store.rowsMatching(re);
+        }
+        else
+        {
+            rows = store.rowsContaining(key);
+        }
+        store = store.subset(rows);
+    }
+    return ok;
+}
+
+/**
+ * 动作命令的参数，全部来自搜索时记录的偏移
+ * 动作没有 exp 时 [0] 为整行、之后为行表达式的各捕获组（内置数据源为各列），
+ * 有 exp 时为 exp 的捕获组
+ */
+QStringList ListHunterCore::actionCaptures(const ResultStore &store, int row, const LineBean &lb, const ActionBean &action)
+{
+    QStringList caps;
+    if (!action.exp.isEmpty())
+    {
+        for (int i = 0; i <= action.regex.captureCount(); i++)
+            caps.append(store.actionCapRef(row, action.capOffset + i).toString());
+        return caps;
+    }
+
+    caps.append(store.rowLine(row));
+    int count = lb.expression.isEmpty() ? store.columnCount() : lb.regex.captureCount();
+    for (int c = 0; c < count && c < store.columnCount(); c++)
+        caps.append(store.cell(row, c));
+    return caps;
+}
+
+/// 对 rows 中可以执行名为 actionName 的动作的行，按 LineBean 分组展开命令
+QList<CommandLine> ListHunterCore::actionCommands(const ResultStore &store, const QVector<int> &rows, const QString &actionName) const
+{
+    QList<CommandLine> cmds;
+    for (int bean = 0; bean < m.resultLineBeans.size(); bean++)
+    {
+        const LineBean& lb = m.resultLineBeans.at(bean);
+        for (int a = 0; a < lb.actions.size() && a < LineBean::maxActions; a++)
+        {
+            const ActionBean& action = lb.actions.at(a);
+            if (action.name != actionName)
+                continue;
+
+            QVector<QStringList> rowCaps;
+            for (int row: rows)
+                if (store.rowBean(row) == bean && (store.rowActions(row) & (quint64(1) << a)))
+                    rowCaps.append(actionCaptures(store, row, lb, action));
+            if (!rowCaps.isEmpty())
+                cmds += action.commands(rowCaps);
+            break;
+        }
+    }
+    return cmds;
+}
@@ -0,0 +1,49 @@
+#ifndef LISTHUNTERCORE_H
+#define LISTHUNTERCORE_H
+
+#include <functional>
+#include "modebean.h"
+#include "resultstore.h"
+
+class LineMatcher;
+
+/**
+ * 不依赖界面的模式引擎：加载模式、执行搜索、匹配结果行、展开动作命令
+ * 界面和 listhunter-cli 共用，只依赖 QtCore
+ */
+class ListHunterCore
+{
+public:
+    ListHunterCore();
+    ~ListHunterCore();
+
+    static bool readModeFile(const QString& path, MyJson* json, QString* error); // 自动判断 UTF-8 或 GBK
+    static bool parseModeJson(const QByteArray& bytes, MyJson* json, QString* error);
+    bool loadModeFile(const QString& path, QStringList* errors);
+    bool loadModeFileCached(const QString& path, const QString& cacheDir, QStringList* errors, bool* fromCache = nullptr);
+    bool loadMode(const MyJson& json, QStringList* errors); // 失败时保留原来的模式
+    const ModeBean& mode() const { return m; }
+    LineMatcher* matcher() const { return lineMatcher; }
+
+    // 流式搜索每匹配完一批输出，把新的结果行 [firstRow, store.rowCount()) 交给调用方
+    typedef std::function<void(const ResultStore& store, int firstRow)> RowsCallback;
+
+    // 阻塞执行关键词对应的搜索，结果写入 store；需要事件循环所在的线程（例如命令行）
+    // 流式搜索的命令不会结束，只能逐批输出，必须提供 rowsReady，一直运行到进程被中断
+    bool search(const QString& key, ResultStore& store, QString* error, const RowsCallback& rowsReady = RowsCallback()) const;
+
+    static QStringList actionCaptures(const ResultStore& store, int row, const LineBean& lb, const ActionBean& action);
+    QList<CommandLine> actionCommands(const ResultStore& store, const QVector<int>& rows, const QString& actionName) const;
+
+private:
+    void setMode(const ModeBean& mode);
+    static QString modeCachePath(const QString& cacheDir, const QString& path);
+    static void writeModeCache(const QString& cachePath, const QString& path, qint64 mtime, qint64 size,
+                               const QByteArray& hash, const ModeBean& mode);
+
+private:
+    ModeBean m;
+    LineMatcher* lineMatcher;
+};
+
+#endif // LISTHUNTERCORE_H
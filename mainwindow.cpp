@@ -1,355 +1,398 @@
-#include <QFileDialog>
-#include <QProcess>
-#include <QStandardItemModel>
-#include <QDesktopServices>
-#include <QTimer>
-#include "mainwindow.h"
-#include "ui_mainwindow.h"
-#include "fileutil.h"
-
-MainWindow::MainWindow(QWidget *parent)
-    : QMainWindow(parent)
-    , ui(new Ui::MainWindow),
-      settings(new MySettings("settings.ini", QSettings::Format::IniFormat))
-{
-    ui->setupUi(this);
-    refreshTimer = new QTimer(this);
-    connect(refreshTimer, SIGNAL(timeout()), this, SLOT(refreshAndKeepSelection()));
-
-    QString path = settings->s("recent/modeFile");
-    if (!path.isEmpty() && isFileExist(path))
-    {
-        loadModeFile(path);
-    }
-}
-
-MainWindow::~MainWindow()
-{
-    delete ui;
-}
-
-void MainWindow::loadModeFile(QString path)
-{
-    QFileInfo info(path);
-    QString name = info.baseName();
-    ui->searchEdit->setPlaceholderText(name);
-
-    QString text = readTextFileAutoCodec(path);
-    bool ok;
-    QString err;
-    MyJson json = MyJson::from(text.toUtf8(), &ok, &err);
-    if (!ok)
-    {
-        qCritical() << "读取模式文件失败：" << err;
-        QMessageBox::critical(this, "加载模式JSON失败", err);
-        return ;
-    }
-    loadMode(json);
-}
-
-void MainWindow::loadMode(MyJson json)
-{
-    QString tip = json.s("placeholder");
-    if (!tip.isEmpty())
-        ui->searchEdit->setPlaceholderText(tip);
-
-    searchTypes.clear();
-    json.each("search_types", [=](const MyJson& line){
-        searchTypes.append(SearchType::fromJson(line));
-    });
-
-    resultTitles.clear();
-    for (auto val: json.a("result_titles"))
-        resultTitles.append(val.toString());
-    LOAD_DEB << "result_titles:" << resultTitles;
-
-    resultLineBeans.clear();
-    json.each("result_lines", [=](const MyJson& line){
-        resultLineBeans.append(LineBean::fromJson(line));
-    });
-
-    timerRefresh = json.i("refresh_timer", 0);
-
-    if (timerRefresh)
-        refreshTimer->start(timerRefresh);
-    else
-        refreshTimer->stop();
-
-    ui->searchEdit->clear();
-    ui->resultTable->setModel(new QStandardItemModel());
-    resultLines.clear();
-}
-
-void MainWindow::saveModeFile(QString path)
-{
-    MyJson json;
-
-    QJsonArray array;
-    for (auto type: searchTypes)
-        array.append(type.toJson());
-    json.insert("search_types", array);
-
-    array = QJsonArray();
-    for (auto title: resultTitles)
-        array.append(title);
-    json.insert("result_titles", array);
-
-    array = QJsonArray();
-    for (auto line: resultLineBeans)
-        array.append(line.toJson());
-    json.insert("result_lines", array);
-
-    if (timerRefresh > 0)
-        json.insert("refresh_timer", timerRefresh);
-
-    writeTextFile(path, json.toBa());
-}
-
-void MainWindow::search(QString key)
-{
-    // 判断要执行的命令
-    QString cmd;
-    for (auto type: searchTypes)
-    {
-        QRegularExpressionMatch match;
-        if (key.indexOf(QRegularExpression(type.keyExp), 0, &match) < 0)
-            continue;
-
-        QStringList caps = match.capturedTexts();
-        cmd = type.searchExp;
-        for (int i = 0; i < caps.size(); i++)
-            cmd.replace("%" + QString::number(i + 1), caps.at(i));
-        break;
-    }
-    if (cmd.isEmpty())
-    {
-        qCritical() << "没有要执行的命令行";
-        QMessageBox::critical(this, "无法搜索", "找不和适合执行的命令行\n[search_types]下没有满足关键词的搜索表达式");
-        return ;
-    }
-
-    // 执行命令行
-    QProcess process;
-    qInfo() << "exec_cmd:" << cmd;
-#if defined(Q_OS_WIN)
-    process.start("cmd", QStringList{"/c", cmd});
-#elif defined(Q_OS_LINUX)
-    process.start("/bin/sh", QStringList{"-c", cmd});
-#else
-    process.start(cmd);
-#endif
-    process.waitForStarted();
-    process.waitForFinished();
-    QString result = QString::fromLocal8Bit(process.readAllStandardOutput());
-    QString error = QString::fromLocal8Bit(process.readAllStandardError());
-    QStringList lines = result.split(QRegularExpression("[\\r\\n]+"), QString::SkipEmptyParts);
-    qInfo() << "result_line_count:" << lines.count();
-    // qInfo() << "result:" << result;
-    if (error != "")
-        qWarning() << "error:" << error;
-    // for (auto line: lines)
-    //    qDebug() << line;
-
-    // 设置表格
-    QStandardItemModel* model = new QStandardItemModel();
-    model->setColumnCount(resultTitles.size());
-    for (int i = 0; i < resultTitles.size(); i++)
-        model->setHeaderData(i, Qt::Horizontal, resultTitles.at(i));
-
-    // 添加到结果
-    int modelLineIndex = 0;
-    resultLines.clear();
-    for (QString lineStr: lines)
-    {
-        // 判断匹配的格式
-        int i;
-        for (i = 0; i < resultLineBeans.size(); i++)
-        {
-            const LineBean& lb = resultLineBeans.at(i);
-            const QString& expression = lb.expression;
-            QRegularExpressionMatch match;
-            if (lineStr.indexOf(QRegularExpression(expression), 0, &match) < 0)
-                continue;
-            if (lb.ignore) // 忽略这一行
-                break;
-
-            // 添加到表格
-            model->setRowCount(modelLineIndex + 1);
-            const QStringList& caps = match.capturedTexts();
-            int maxi = qMin(caps.size() - 1, resultTitles.size());
-            for (int j = 0; j < maxi; j++)
-            {
-                QString cell = caps.at(j + 1);
-                // 添加到单元格里面
-                model->setItem(modelLineIndex, j, new QStandardItem(cell));
-            }
-            modelLineIndex++;
-            resultLines.append(lineStr);
-            break;
-        }
-        if (i == resultLineBeans.size())
-            ; // 没有适合匹配的
-    }
-    ui->resultTable->setModel(model);
-    ui->resultTable->resizeColumnsToContents();
-}
-
-void MainWindow::runCmds(QString cmd)
-{
-    QProcess process;
-    qInfo() << "exec_cmd:" << cmd;
-    process.start(cmd);
-    process.waitForStarted();
-    process.waitForFinished();
-    QString result = QString::fromLocal8Bit(process.readAllStandardOutput());
-    qInfo() << "result:" << result;
-}
-
-void MainWindow::refreshAndKeepSelection()
-{
-    // 保存选择
-
-    // 开始搜索
-    on_searchButton_clicked();
-
-    // 恢复选择
-}
-
-void MainWindow::on_searchButton_clicked()
-{
-    search(ui->searchEdit->text());
-}
-
-void MainWindow::on_actionSaveMode_triggered()
-{
-    QString path = QFileDialog::getSaveFileName(this, "保存模式文件", settings->s("recent/modeFile"), "*.json");
-    if (path.isEmpty())
-        return ;
-    settings->set("recent/modeFile", path);
-    saveModeFile(path);
-}
-
-void MainWindow::on_actionLoadMode_triggered()
-{
-    QString path = QFileDialog::getOpenFileName(this, "打开模式文件", settings->s("recent/modeFile"), "*.json");
-    if (path.isEmpty())
-        return ;
-    settings->set("recent/modeFile", path);
-
-    loadModeFile(path);
-}
-
-void MainWindow::on_searchEdit_returnPressed()
-{
-    search(ui->searchEdit->text());
-}
-
-void MainWindow::showEvent(QShowEvent *e)
-{
-    restoreGeometry(settings->value("mainwindow/geometry").toByteArray());
-    return QMainWindow::showEvent(e);
-}
-
-void MainWindow::closeEvent(QCloseEvent *e)
-{
-    settings->set("mainwindow/geometry", saveGeometry());
-    return QMainWindow::closeEvent(e);
-}
-
-void MainWindow::on_resultTable_customContextMenuRequested(const QPoint&)
-{
-    auto rows = ui->resultTable->selectionModel()->selectedRows(0);
-    if (!rows.size())
-        return ;
-
-    QMenu* menu = new QMenu;
-    int row = rows.first().row();
-    if (row < 0 || row >= resultLines.size())
-        return ;
-    QString str = resultLines.at(row);
-
-    auto canAllResultMatch = [=](const QString& re) -> bool {
-        for (auto ri: rows)
-        {
-            if (!resultLines.at(ri.row()).contains(QRegularExpression(re)))
-            {
-                return false;
-            }
-        }
-        return true;
-    };
-
-    QRegularExpressionMatch match;
-    for (int i = 0; i < resultLineBeans.size(); i++)
-    {
-        const LineBean& lb = resultLineBeans.at(i);
-        if (str.indexOf(QRegularExpression(lb.expression), 0, &match) < 0)
-            continue;
-        if (!canAllResultMatch(lb.expression))
-            continue;
-
-        // 匹配到这一个action组，遍历是否所有action都可以匹配
-        QStringList caps = match.capturedTexts();
-        for (auto action: lb.actions)
-        {
-            QAction* act = new QAction(action.name, menu);
-            QString cmd = action.cmd;
-
-            // 判断action自己的表达式
-            if (!action.exp.isEmpty())
-            {
-                if (str.indexOf(QRegularExpression(action.exp), 0, &match) < 0)
-                    continue;
-                if (!canAllResultMatch(action.exp))
-                    continue;
-                caps = match.capturedTexts();
-            }
-
-            // 设置执行cmd
-            connect(act, &QAction::triggered, this, [=]{
-                QString re = action.exp.isEmpty() ? lb.expression : action.exp;
-                QRegularExpressionMatch match;
-                for (auto ri: rows) // 遍历每一行
-                {
-                    if (resultLines.at(ri.row()).indexOf(QRegularExpression(re), 0, &match) == -1)
-                    {
-                        qWarning() << "action.cmd匹配失败：" << resultLines.at(ri.row()) << " ==> " << re;
-                        continue;
-                    }
-                    QStringList caps = match.capturedTexts();
-                    QString t_cmd = cmd;
-                    for (int i = 0; i < caps.size(); i++)
-                    {
-                        t_cmd.replace("%" + QString::number(i), caps.at(i));
-                    }
-                    runCmds(t_cmd);
-                }
-                if (action.refresh)
-                    on_searchButton_clicked();
-            });
-
-            // 添加菜单
-            menu->addAction(act);
-        }
-        break;
-    }
-
-    if (menu->actions().size() == 0)
-    {
-        delete menu;
-        return ;
-    }
-    menu->exec(QCursor::pos());
-}
-
-void MainWindow::on_actionGitHub_triggered()
-{
-    QDesktopServices::openUrl(QUrl("https://github.com/iwxyi/ListHunter"));
-}
-
-void MainWindow::on_resultTable_pressed(const QModelIndex &index)
-{
-    // 如果开了定时刷新，重新等待刷新延时
-    if (refreshTimer->isActive())
-        refreshTimer->start();
-}
+#include <QFileDialog>
+#include <QDesktopServices>
+#include <QTimer>
+#include <QInputDialog>
+#include <QLabel>
+#include <QJsonDocument>
+#include "mainwindow.h"
+#include "ui_mainwindow.h"
+#include "fileutil.h"
+#include "modetab.h"
+#include "actionexecutor.h"
+#include "processlimiter.h"
+
+MainWindow::MainWindow(QWidget *parent)
+    : QMainWindow(parent)
+    , ui(new Ui::MainWindow),
+      settings(new MySettings("settings.ini", QSettings::Format::IniFormat))
+{
+    qint64 startupTime = SearchTrace::now();
+    ui->setupUi(this);
+    ProcessLimiter::instance()->setMaxProcesses(settings->i("process/maxRunning", 8));
+    actionExecutor = new ActionExecutor(this);
+    actionExecutor->setMaxRunning(settings->i("action/maxRunning", 4));
+    connect(actionExecutor, SIGNAL(taskStarted(int)), this, SLOT(actionStarted(int)));
+    connect(actionExecutor, SIGNAL(taskFinished(int, int, bool, const QString&)), this, SLOT(actionFinished(int, int, bool, const QString&)));
+    connect(actionExecutor, SIGNAL(allFinished()), this, SLOT(actionsAllFinished()));
+    ui->actionDock->hide();
+    traceLabel = new QLabel(this);
+    ui->statusbar->addPermanentWidget(traceLabel);
+
+    // 恢复上次打开的标签页，兼容只记录了一个模式的旧配置
+    QStringList paths = settings->value("recent/modeFiles").toStringList();
+    if (paths.isEmpty() && !settings->s("recent/modeFile").isEmpty())
+        paths.append(settings->s("recent/modeFile"));
+    for (const QString& path: paths)
+    {
+        if (isFileExist(path))
+            loadModeFile(path, true);
+    }
+    if (!ui->tabWidget->count())
+        addTab();
+    ui->tabWidget->setCurrentIndex(qBound(0, settings->i("recent/currentTab", 0), ui->tabWidget->count() - 1));
+    qInfo() << "startup_us:" << (SearchTrace::now() - startupTime) / 1000;
+}
+
+MainWindow::~MainWindow()
+{
+    delete ui;
+}
+
+ModeTab *MainWindow::addTab()
+{
+    ModeTab* tab = new ModeTab(settings, nextTabId++, ui->tabWidget);
+    connect(tab, SIGNAL(statusChanged(const QString&)), this, SLOT(tabStatusChanged(const QString&)));
+    connect(tab, SIGNAL(actionsRequested(const QList<CommandLine>&, bool)), this, SLOT(runActionCmds(const QList<CommandLine>&, bool)));
+    connect(tab, SIGNAL(searchTraced(const SearchTrace&)), this, SLOT(tabSearchTraced(const SearchTrace&)));
+    tab->setActive(false);
+    tab->setWindowVisible(isVisible() && !isMinimized());
+    ui->tabWidget->setCurrentIndex(ui->tabWidget->addTab(tab, tab->title()));
+    return tab;
+}
+
+/// 在当前标签页（没有时新建）或新标签页中加载模式，新标签页加载失败时关闭
+void MainWindow::loadModeFile(QString path, bool newTab)
+{
+    ModeTab* tab = newTab ? nullptr : currentTab();
+    bool created = !tab;
+    if (created)
+        tab = addTab();
+    if (!tab->loadModeFile(path))
+    {
+        if (created)
+            on_tabWidget_tabCloseRequested(ui->tabWidget->indexOf(tab));
+        return ;
+    }
+    int index = ui->tabWidget->indexOf(tab);
+    ui->tabWidget->setTabText(index, tab->title());
+    ui->tabWidget->setTabToolTip(index, path);
+}
+
+void MainWindow::on_tabWidget_currentChanged(int index)
+{
+    ModeTab* current = qobject_cast<ModeTab*>(ui->tabWidget->widget(index));
+    for (ModeTab* tab: tabs())
+        tab->setActive(tab == current);
+    ui->statusbar->showMessage(current ? current->statusText() : "");
+    updateTraceLabel(current);
+}
+
+void MainWindow::on_tabWidget_tabCloseRequested(int index)
+{
+    QWidget* tab = ui->tabWidget->widget(index);
+    if (!tab)
+        return ;
+    ui->tabWidget->removeTab(index);
+    tab->deleteLater(); // 结束这个标签页的搜索进程
+}
+
+/// 只显示当前标签页的状态，后台标签页的状态切换过去时再显示
+void MainWindow::tabStatusChanged(const QString &msg)
+{
+    if (sender() == currentTab())
+        ui->statusbar->showMessage(msg);
+}
+
+/// 所有标签页的搜索耗时都加入历史记录，状态栏右侧显示当前标签页最近一次
+void MainWindow::tabSearchTraced(const SearchTrace &trace)
+{
+    ModeTab* tab = qobject_cast<ModeTab*>(sender());
+    if (!tab)
+        return ;
+    traceHistory.append(qMakePair(tab->id(), trace));
+    while (traceHistory.size() > maxTraceHistory)
+        traceHistory.removeFirst();
+    if (tab == currentTab())
+        updateTraceLabel(tab);
+}
+
+void MainWindow::updateTraceLabel(ModeTab *tab)
+{
+    // 悬停显示最近几次，最新的在上
+    QStringList recent;
+    for (int i = traceHistory.size() - 1; i >= 0 && recent.size() < 20; i--)
+        recent.append(traceHistory.at(i).second.name() + "\n    " + traceHistory.at(i).second.summary());
+    traceLabel->setText(tab ? tab->traceSummary() : "");
+    traceLabel->setToolTip(recent.join("\n"));
+}
+
+ModeTab *MainWindow::currentTab() const
+{
+    return qobject_cast<ModeTab*>(ui->tabWidget->currentWidget());
+}
+
+QList<ModeTab *> MainWindow::tabs() const
+{
+    QList<ModeTab*> list;
+    for (int i = 0; i < ui->tabWidget->count(); i++)
+        if (ModeTab* tab = qobject_cast<ModeTab*>(ui->tabWidget->widget(i)))
+            list.append(tab);
+    return list;
+}
+
+/**
+ * 动作命令交给 actionExecutor 并行执行，进度显示在动作结果面板
+ * 所有命令结束后，发起带 refresh 动作的标签页各刷新一次
+ */
+void MainWindow::runActionCmds(const QList<CommandLine> &cmds, bool refresh)
+{
+    if (cmds.isEmpty())
+        return ;
+    if (actionExecutor->isIdle())
+    {
+        ui->actionTable->setRowCount(0);
+        actionRows.clear();
+        actionDone = actionFailed = 0;
+    }
+    ModeTab* tab = qobject_cast<ModeTab*>(sender());
+    if (refresh && tab && !actionRefreshTabs.contains(tab))
+        actionRefreshTabs.append(tab);
+
+    int row = ui->actionTable->rowCount();
+    ui->actionTable->setRowCount(row + cmds.size());
+    for (const CommandLine& cmd: cmds)
+    {
+        qInfo() << "exec_cmd:" << cmd.text() << "direct:" << cmd.isDirect();
+        ui->actionTable->setItem(row, 0, new QTableWidgetItem(cmd.text()));
+        ui->actionTable->setItem(row, 1, new QTableWidgetItem("等待"));
+        actionRows.insert(actionExecutor->enqueue(cmd), row);
+        row++;
+    }
+    ui->actionDock->show();
+    ui->statusbar->showMessage(QString("正在执行动作 %1/%2").arg(actionDone).arg(ui->actionTable->rowCount()));
+}
+
+void MainWindow::actionStarted(int task)
+{
+    int row = actionRows.value(task, -1);
+    if (row >= 0)
+        ui->actionTable->item(row, 1)->setText("运行中");
+}
+
+void MainWindow::actionFinished(int task, int exitCode, bool ok, const QString &output)
+{
+    qInfo() << "action_finished:" << task << exitCode << output;
+    actionDone++;
+    if (!ok || exitCode != 0)
+        actionFailed++;
+    int row = actionRows.take(task);
+    ui->actionTable->item(row, 1)->setText(ok ? (exitCode == 0 ? "完成" : "失败") : "出错");
+    ui->actionTable->setItem(row, 2, new QTableWidgetItem(QString::number(exitCode)));
+    ui->actionTable->setItem(row, 3, new QTableWidgetItem(output.section('\n', 0, 0)));
+    ui->actionTable->item(row, 3)->setToolTip(output);
+    ui->statusbar->showMessage(QString("正在执行动作 %1/%2").arg(actionDone).arg(ui->actionTable->rowCount()));
+}
+
+void MainWindow::actionsAllFinished()
+{
+    QString msg = QString("%1 个动作已执行").arg(actionDone);
+    if (actionFailed)
+        msg += QString("，%1 个失败").arg(actionFailed);
+    ui->statusbar->showMessage(msg);
+    ui->actionTable->resizeColumnToContents(1);
+    ui->actionTable->resizeColumnToContents(2);
+
+    QList<QPointer<ModeTab>> refreshTabs = actionRefreshTabs;
+    actionRefreshTabs.clear();
+    for (const QPointer<ModeTab>& tab: refreshTabs)
+    {
+        if (tab) // 标签页可能已经关闭
+            tab->refresh();
+    }
+}
+
+void MainWindow::on_actionNewTab_triggered()
+{
+    QString path = QFileDialog::getOpenFileName(this, "在新标签页中打开模式", settings->s("recent/modeFile"), "*.json");
+    if (path.isEmpty())
+        return ;
+    settings->set("recent/modeFile", path);
+    loadModeFile(path, true);
+}
+
+void MainWindow::on_actionSaveMode_triggered()
+{
+    ModeTab* tab = currentTab();
+    if (!tab)
+        return ;
+    QString path = QFileDialog::getSaveFileName(this, "保存模式文件", settings->s("recent/modeFile"), "*.json");
+    if (path.isEmpty())
+        return ;
+    settings->set("recent/modeFile", path);
+    tab->saveModeFile(path);
+}
+
+void MainWindow::on_actionLoadMode_triggered()
+{
+    QString path = QFileDialog::getOpenFileName(this, "打开模式文件", settings->s("recent/modeFile"), "*.json");
+    if (path.isEmpty())
+        return ;
+    settings->set("recent/modeFile", path);
+
+    loadModeFile(path);
+}
+
+void MainWindow::showEvent(QShowEvent *e)
+{
+    restoreGeometry(settings->value("mainwindow/geometry").toByteArray());
+    QMainWindow::showEvent(e);
+    updateWindowVisible();
+}
+
+void MainWindow::hideEvent(QHideEvent *e)
+{
+    QMainWindow::hideEvent(e);
+    updateWindowVisible();
+}
+
+void MainWindow::changeEvent(QEvent *e)
+{
+    QMainWindow::changeEvent(e);
+    if (e->type() == QEvent::WindowStateChange)
+        updateWindowVisible();
+}
+
+/// 窗口最小化或隐藏时暂停所有标签页的定时刷新，恢复时立即刷新一次
+void MainWindow::updateWindowVisible()
+{
+    bool visible = isVisible() && !isMinimized();
+    for (ModeTab* tab: tabs())
+        tab->setWindowVisible(visible);
+}
+
+void MainWindow::closeEvent(QCloseEvent *e)
+{
+    settings->set("mainwindow/geometry", saveGeometry());
+
+    // 记录打开的标签页，下次启动时恢复
+    QStringList paths;
+    int current = 0;
+    for (ModeTab* tab: tabs())
+    {
+        if (tab->modeFile().isEmpty())
+            continue;
+        if (tab == currentTab())
+            current = paths.size();
+        paths.append(tab->modeFile());
+    }
+    settings->set("recent/modeFiles", paths);
+    settings->set("recent/currentTab", current);
+    return QMainWindow::closeEvent(e);
+}
+
+void MainWindow::on_actionMatchThreads_triggered()
+{
+    bool ok;
+    int count = QInputDialog::getInt(this, "匹配线程数", "并行匹配输出行的线程数（0 为 CPU 核心数）",
+                                     settings->i("search/matchThreads", 0), 0, 256, 1, &ok);
+    if (!ok)
+        return ;
+    settings->set("search/matchThreads", count);
+    for (ModeTab* tab: tabs())
+        tab->setMatchThreads(count);
+}
+
+void MainWindow::on_actionLiveSearchDelay_triggered()
+{
+    bool ok;
+    int delay = QInputDialog::getInt(this, "边输入边搜索", "停止输入多久后开始搜索（毫秒，0 为关闭）",
+                                     settings->i("search/liveDelay", 300), 0, 10000, 50, &ok);
+    if (!ok)
+        return ;
+    settings->set("search/liveDelay", delay);
+}
+
+void MainWindow::on_actionMaxRunning_triggered()
+{
+    bool ok;
+    int count = QInputDialog::getInt(this, "动作并发数", "右键动作同时运行的命令数",
+                                     settings->i("action/maxRunning", 4), 1, 64, 1, &ok);
+    if (!ok)
+        return ;
+    settings->set("action/maxRunning", count);
+    actionExecutor->setMaxRunning(count);
+}
+
+void MainWindow::on_actionMaxProcesses_triggered()
+{
+    bool ok;
+    int count = QInputDialog::getInt(this, "子进程上限", "所有标签页的搜索和动作同时运行的进程数（0 为不限制）",
+                                     settings->i("process/maxRunning", 8), 0, 256, 1, &ok);
+    if (!ok)
+        return ;
+    settings->set("process/maxRunning", count);
+    ProcessLimiter::instance()->setMaxProcesses(count);
+}
+
+void MainWindow::on_actionRefreshBudget_triggered()
+{
+    bool ok;
+    int percent = QInputDialog::getInt(this, "刷新耗时上限", "搜索命令耗时占刷新间隔的百分比上限，超过时自动拉长间隔（0 为不限制）",
+                                       settings->i("refresh/cpuBudget", 25), 0, 100, 5, &ok);
+    if (!ok)
+        return ;
+    settings->set("refresh/cpuBudget", percent);
+    for (ModeTab* tab: tabs())
+        tab->setRefreshBudget(percent);
+}
+
+void MainWindow::on_actionMemoryLimit_triggered()
+{
+    bool ok;
+    int mb = QInputDialog::getInt(this, "结果内存上限", "每个标签页的结果在内存中的上限（MB），超过后较早的行写入临时文件（0 为不限制）",
+                                  settings->i("result/memoryLimit", 512), 0, 65536, 64, &ok);
+    if (!ok)
+        return ;
+    settings->set("result/memoryLimit", mb);
+    for (ModeTab* tab: tabs())
+        tab->setMemoryLimit(mb);
+}
+
+void MainWindow::on_actionBackgroundRefresh_triggered()
+{
+    bool ok;
+    int factor = QInputDialog::getInt(this, "后台标签页刷新", "不在前台的标签页刷新间隔放大的倍数（0 为暂停刷新）",
+                                      settings->i("tabs/backgroundRefresh", 0), 0, 100, 1, &ok);
+    if (!ok)
+        return ;
+    settings->set("tabs/backgroundRefresh", factor);
+    ModeTab* current = currentTab();
+    for (ModeTab* tab: tabs())
+        tab->setActive(tab == current);
+}
+
+/// 按 Chrome trace event 格式导出最近的搜索耗时，可在 chrome://tracing 或 Perfetto 中打开，每个标签页一组线程
+void MainWindow::on_actionExportTrace_triggered()
+{
+    if (traceHistory.isEmpty())
+    {
+        QMessageBox::information(this, "导出耗时记录", "还没有搜索记录");
+        return ;
+    }
+    QString path = QFileDialog::getSaveFileName(this, "导出耗时记录", "listhunter_trace.json", "*.json");
+    if (path.isEmpty())
+        return ;
+
+    QJsonArray events;
+    for (const QPair<int, SearchTrace>& t: traceHistory)
+        t.second.appendTraceEvents(events, t.first);
+    QJsonObject root;
+    root.insert("traceEvents", events);
+    root.insert("displayTimeUnit", "ms");
+    writeTextFile(path, QJsonDocument(root).toJson(QJsonDocument::Compact));
+}
+
+void MainWindow::on_actionGitHub_triggered()
+{
+    QDesktopServices::openUrl(QUrl("https://github.com/iwxyi/ListHunter"));
+}
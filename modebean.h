@@ -0,0 +1,499 @@
+#ifndef MODEBEAN_H
+#define MODEBEAN_H
+
+#include <QRegularExpression>
+#include <QStringList>
+#include <QSet>
+#include <QDataStream>
+#include <QDebug>
+#include "myjson.h"
+#include "nativesource.h"
+#include "resultquery.h"
+#include "commandline.h"
+
+#define LOAD_DEB if (0) qInfo()
+
+/**
+ * 加载模式时编译正则表达式
+ * 立即 optimize()，让 PCRE 在加载时就完成 JIT，搜索时不再重复编译
+ * 编译失败时把出错位置写入 errors
+ */
+inline QRegularExpression compileModeExp(const QString& exp, const QString& where, QStringList* errors)
+{
+    QRegularExpression re(exp);
+    if (!re.isValid())
+    {
+        if (errors)
+            errors->append(QString("%1：%2\n    %3（位置 %4）")
+                           .arg(where).arg(exp).arg(re.errorString()).arg(re.patternErrorOffset()));
+        return re;
+    }
+    re.optimize();
+    return re;
+}
+
+struct ActionBean
+{
+    QString name; // 操作名字：【结束程序】
+    QString cmd; // 操作命令：【taskkill /pid %1 /f】
+    QString exp; // （可空）使用自己表达式的match（不匹配则跳过），而不是行匹配后的match；会影响后面的action
+    QRegularExpression regex; // exp 编译后的正则，exp 为空时无效
+    CommandLine command; // cmd 拆分后的参数，不需要 shell 时直接启动
+    bool refresh = false;
+    bool merge = false; // 选中多行时合并成一条命令：【kill -9 %2】 → 【kill -9 101 102 103】
+    char aaa[2];
+    int capOffset = -1; // exp 的捕获组（含 [0]）在每行动作捕获中的起点，exp 为空时为 -1
+
+    static ActionBean fromJson(const MyJson& json, QStringList* errors = nullptr)
+    {
+        ActionBean ob;
+        ob.name = json.s("name");
+        LOAD_DEB << "        name:" << ob.name;
+        ob.cmd = json.s("cmd");
+        LOAD_DEB << "        cmd:" << ob.cmd;
+        ob.command = CommandLine(ob.cmd);
+        ob.exp = json.s("exp");
+        LOAD_DEB << "        exp:" << ob.exp;
+        if (!ob.exp.isEmpty())
+            ob.regex = compileModeExp(ob.exp, "action[" + ob.name + "].exp", errors);
+        ob.refresh = json.b("refresh");
+        ob.merge = json.b("merge");
+        return ob;
+    }
+
+    /// 模式缓存：读取时重新编译正则，不再经过 JSON
+    static ActionBean fromStream(QDataStream& in)
+    {
+        ActionBean ob;
+        in >> ob.name >> ob.cmd >> ob.exp >> ob.refresh >> ob.merge >> ob.capOffset;
+        ob.command = CommandLine(ob.cmd);
+        if (!ob.exp.isEmpty())
+            ob.regex = compileModeExp(ob.exp, "", nullptr);
+        return ob;
+    }
+
+    void toStream(QDataStream& out) const
+    {
+        out << name << cmd << exp << refresh << merge << capOffset;
+    }
+
+    /// 把捕获组填入命令，%0 为整行
+    CommandLine fillCmd(const QStringList& caps) const
+    {
+        return command.fill(caps, 0);
+    }
+
+    /**
+     * 选中各行要执行的命令
+     * merge 时每个 %n 替换为各行第 n 个捕获组（去重后以空格连接），
+     * 超过命令行长度限制时拆成多条
+     */
+    QList<CommandLine> commands(const QVector<QStringList>& rowCaps) const
+    {
+        QList<CommandLine> cmds;
+        if (!merge)
+        {
+            for (const QStringList& caps: rowCaps)
+                cmds.append(fillCmd(caps));
+            return cmds;
+        }
+
+        const int maxLength = 8000; // Windows 命令行最长 8191 个字符
+        int capCount = 0;
+        for (const QStringList& caps: rowCaps)
+            capCount = qMax(capCount, caps.size());
+        QList<int> used; // 命令中出现的 %n
+        for (int i = 0; i < capCount; i++)
+            if (cmd.contains("%" + QString::number(i)))
+                used.append(i);
+
+        QVector<QStringList> values(capCount);
+        QVector<QSet<QString>> seen(capCount);
+        int length = cmd.size();
+        auto flush = [&]{
+            if (length == cmd.size())
+                return ;
+            QStringList caps;
+            for (int i = 0; i < capCount; i++)
+                caps.append(values.at(i).join(" "));
+            cmds.append(fillCmd(caps));
+            values = QVector<QStringList>(capCount);
+            seen = QVector<QSet<QString>>(capCount);
+            length = cmd.size();
+        };
+        auto addedLength = [&](const QStringList& caps) {
+            int added = 0;
+            for (int i: used)
+                if (i < caps.size() && !seen.at(i).contains(caps.at(i)))
+                    added += caps.at(i).size() + 1;
+            return added;
+        };
+
+        for (const QStringList& caps: rowCaps)
+        {
+            int added = addedLength(caps);
+            if (!added)
+                continue;
+            if (length + added > maxLength && length > cmd.size())
+            {
+                flush();
+                added = addedLength(caps);
+            }
+            for (int i: used)
+            {
+                if (i < caps.size() && !seen.at(i).contains(caps.at(i)))
+                {
+                    seen[i].insert(caps.at(i));
+                    values[i].append(caps.at(i));
+                }
+            }
+            length += added;
+        }
+        flush();
+        return cmds;
+    }
+
+    MyJson toJson() const
+    {
+        MyJson json;
+        json.add("name", name).add("cmd", cmd).add("exp", exp).add("refresh", refresh);
+        if (merge)
+            json.add("merge", merge);
+        QJsonArray array;
+        json.add("args", array);
+        return json;
+    }
+};
+
+struct LineBean
+{
+    QString expression; // 符合这一行的正则表达式，每个捕获组都是一个标签
+    /* 【^\s*(\w+)\s+([\d\.:]+)\s+([\d\.:]+)\s+LISTENING\s+(\d+)\s*$】 */
+    /*   TCP    0.0.0.0:5520           0.0.0.0:0              LISTENING       24536
+         TCP    [::]:5520              [::]:0                 LISTENING       24536 */
+    QRegularExpression regex; // expression 编译后的正则
+    QList<ActionBean> actions; // 菜单操作
+    bool ignore = false;
+    char aaa[3];
+    int actionCapCount = 0; // 每行要记录的动作捕获组总数
+    static const int maxActions = 64; // 每行可用的动作按位记录
+
+    static LineBean fromJson(const MyJson& json, QStringList* errors = nullptr)
+    {
+        LineBean lb;
+        lb.expression = json.s("expression");
+        LOAD_DEB << "    line_exp:" << lb.expression;
+        lb.regex = compileModeExp(lb.expression, "result_lines.expression", errors);
+        lb.ignore = json.b("ignore", lb.ignore);
+        for (auto val: json.a("actions"))
+            lb.actions.append(ActionBean::fromJson(val.toObject(), errors));
+        if (lb.actions.size() > maxActions && errors)
+            errors->append(QString("result_lines.actions：最多 %1 个动作").arg(maxActions));
+
+        // 搜索时每行按这个布局记录各动作 exp 的捕获组
+        for (auto& action: lb.actions)
+        {
+            if (action.exp.isEmpty())
+                continue;
+            action.capOffset = lb.actionCapCount;
+            lb.actionCapCount += action.regex.captureCount() + 1;
+        }
+        return lb;
+    }
+
+    static LineBean fromStream(QDataStream& in)
+    {
+        LineBean lb;
+        int count = 0;
+        in >> lb.expression >> lb.ignore >> lb.actionCapCount >> count;
+        lb.regex = compileModeExp(lb.expression, "", nullptr);
+        for (int i = 0; i < count && in.status() == QDataStream::Ok; i++)
+            lb.actions.append(ActionBean::fromStream(in));
+        return lb;
+    }
+
+    void toStream(QDataStream& out) const
+    {
+        out << expression << ignore << actionCapCount << actions.size();
+        for (const ActionBean& action: actions)
+            action.toStream(out);
+    }
+
+    MyJson toJson() const
+    {
+        MyJson json;
+        json.add("expression", expression)
+                .add("ignore", ignore);
+        QJsonArray array;
+        for (auto action: actions)
+            array.append(action.toJson());
+        json.add("actions", array);
+        return json;
+    }
+};
+
+struct SearchType
+{
+    QString keyExp; // 关键词的表达式：【^(\d+)$】
+    QString searchExp; // 搜索的表达式：【netstat -ano | findstr %1】
+    QRegularExpression keyRegex; // keyExp 编译后的正则
+    CommandLine command; // searchExp 拆分后的参数，末尾的 grep 等管道命令在进程内执行
+    bool stream = false; // 命令持续运行（tail -F、journalctl -f），输出随到随显示
+
+    static SearchType fromJson(const MyJson& json, QStringList* errors = nullptr)
+    {
+        SearchType st;
+        st.keyExp = json.s("key_exp");
+        st.searchExp = json.s("search_exp");
+        LOAD_DEB << "search_exp:" << st.keyExp << st.searchExp;
+        st.keyRegex = compileModeExp(st.keyExp, "search_types.key_exp", errors);
+        st.command = CommandLine(st.searchExp, true);
+        st.stream = json.b("stream", false);
+        return st;
+    }
+
+    static SearchType fromStream(QDataStream& in)
+    {
+        SearchType st;
+        in >> st.keyExp >> st.searchExp >> st.stream;
+        st.keyRegex = compileModeExp(st.keyExp, "", nullptr);
+        st.command = CommandLine(st.searchExp, true);
+        return st;
+    }
+
+    void toStream(QDataStream& out) const
+    {
+        out << keyExp << searchExp << stream;
+    }
+
+    MyJson toJson() const
+    {
+        MyJson json;
+        json.add("key_exp", keyExp).add("search_exp", searchExp);
+        if (stream)
+            json.add("stream", stream);
+        return json;
+    }
+};
+
+/**
+ * 编译后的模式
+ * 所有正则在加载时编译一次，搜索、右键菜单、执行操作都复用
+ */
+struct ModeBean
+{
+    enum KeyFilter
+    {
+        NoKeyFilter, // 每次搜索都执行关键词对应的命令
+        TextKeyFilter, // 缓存基础命令的结果，按子串筛选
+        RegexKeyFilter // 缓存基础命令的结果，关键词作为正则筛选
+    };
+
+    QString placeholder; // 搜索框中显示的提示
+    QString source; // 内置数据源，不为空时不执行 search_types 中的命令
+    QList<SearchType> searchTypes;
+    QStringList resultTitles;
+    QStringList columnKeys; // [列] 查询中使用的列名，可为空
+    QList<int> columnTypes; // [列] ResultQuery::ColumnType，查询时按类型比较和排序
+    QList<LineBean> resultLineBeans; // 每一行搜索结果
+    int refreshTimer = 0; // 定时刷新间隔（毫秒），0为不刷新
+    int timeoutMs = 0; // 搜索命令超时（毫秒），0为不限制
+    int refreshKey = -1; // 定时刷新时用来对比新旧行的列，-1为整行
+    bool refreshHighlight = false; // 定时刷新后高亮新增和变化的行
+    int keyFilter = NoKeyFilter;
+    QList<int> columnWidths; // 固定列宽（像素），0 或省略的列自动调整
+    int streamMaxRows = 10000; // 流式搜索最多保留的行数，超过时丢弃最早的行；0 为不限制
+
+    /// 任意一个正则编译失败都会写入 errors，调用者应放弃这个模式
+    static ModeBean fromJson(const MyJson& json, QStringList* errors = nullptr)
+    {
+        ModeBean mode;
+        mode.placeholder = json.s("placeholder");
+
+        for (auto val: json.a("search_types"))
+            mode.searchTypes.append(SearchType::fromJson(val.toObject(), errors));
+
+        mode.source = json.s("source");
+        if (!mode.source.isEmpty() && !NativeSource::isSupported(mode.source) && errors)
+            errors->append("source：不支持的数据源 " + mode.source);
+
+        // 可以是标题，也可以是 {"title": "PID", "key": "pid", "type": "int"}
+        for (auto val: json.a("result_titles"))
+        {
+            MyJson column = val.toObject();
+            QString title = val.isObject() ? column.s("title") : val.toString();
+            int type = ResultQuery::columnType(column.s("type"));
+            if (type < 0 && errors)
+                errors->append("result_titles：" + title + " 的类型只能是 int、ip:port 或 string");
+            mode.resultTitles.append(title);
+            mode.columnKeys.append(column.s("key"));
+            mode.columnTypes.append(qMax(type, 0));
+        }
+        if (mode.resultTitles.isEmpty() && !mode.source.isEmpty())
+        {
+            mode.resultTitles = NativeSource::titles(mode.source);
+            mode.columnKeys = NativeSource::columnKeys(mode.source);
+            mode.columnTypes = NativeSource::columnTypes(mode.source);
+        }
+        LOAD_DEB << "result_titles:" << mode.resultTitles;
+
+        for (auto val: json.a("result_lines"))
+            mode.resultLineBeans.append(LineBean::fromJson(val.toObject(), errors));
+
+        mode.refreshTimer = json.i("refresh_timer", 0);
+        mode.timeoutMs = json.i("timeout_ms", 0);
+
+        // 可以是标题，也可以是从1开始的列序号（与 %1 一致）
+        QJsonValue key = json.value("refresh_key");
+        if (key.isString())
+        {
+            mode.refreshKey = mode.resultTitles.indexOf(key.toString());
+            if (mode.refreshKey < 0 && errors)
+                errors->append("refresh_key：" + key.toString() + " 不在 result_titles 中");
+        }
+        else if (key.isDouble())
+        {
+            mode.refreshKey = key.toInt() - 1;
+        }
+        mode.refreshHighlight = json.b("refresh_highlight", false);
+
+        for (auto val: json.a("column_widths"))
+            mode.columnWidths.append(val.toInt());
+
+        QString filter = json.s("key_filter");
+        if (filter == "text")
+            mode.keyFilter = TextKeyFilter;
+        else if (filter == "regex")
+            mode.keyFilter = RegexKeyFilter;
+        else if (!filter.isEmpty() && errors)
+            errors->append("key_filter：只能是 text 或 regex");
+        if (mode.keyFilter != NoKeyFilter && mode.source.isEmpty() && mode.searchCmd("").isEmpty() && errors)
+            errors->append("key_filter：search_types 中没有匹配空关键词的基础命令");
+
+        mode.streamMaxRows = qMax(0, json.i("stream_max_rows", 10000));
+        for (const SearchType& type: mode.searchTypes)
+            if (type.stream && mode.keyFilter != NoKeyFilter && errors)
+                errors->append("stream：流式搜索不能与 key_filter 同时使用");
+        return mode;
+    }
+
+    /**
+     * 模式缓存的内容，字段顺序即格式，修改时需要增加 ListHunterCore 中的缓存版本号
+     * 只保存加载后的结果（包括 JSON 中省略而推导出的字段），读取时不再校验
+     */
+    static ModeBean fromStream(QDataStream& in)
+    {
+        ModeBean mode;
+        int typeCount = 0, lineCount = 0;
+        in >> mode.placeholder >> mode.source >> typeCount;
+        for (int i = 0; i < typeCount && in.status() == QDataStream::Ok; i++)
+            mode.searchTypes.append(SearchType::fromStream(in));
+        in >> mode.resultTitles >> mode.columnKeys >> mode.columnTypes >> lineCount;
+        for (int i = 0; i < lineCount && in.status() == QDataStream::Ok; i++)
+            mode.resultLineBeans.append(LineBean::fromStream(in));
+        in >> mode.refreshTimer >> mode.timeoutMs >> mode.refreshKey >> mode.refreshHighlight
+           >> mode.keyFilter >> mode.columnWidths >> mode.streamMaxRows;
+        return mode;
+    }
+
+    void toStream(QDataStream& out) const
+    {
+        out << placeholder << source << searchTypes.size();
+        for (const SearchType& type: searchTypes)
+            type.toStream(out);
+        out << resultTitles << columnKeys << columnTypes << resultLineBeans.size();
+        for (const LineBean& lb: resultLineBeans)
+            lb.toStream(out);
+        out << refreshTimer << timeoutMs << refreshKey << refreshHighlight
+            << keyFilter << columnWidths << streamMaxRows;
+    }
+
+    /// 结果中保存的列数：标题之外多出的捕获组也保留，动作命令中的 %n 可以使用
+    int captureColumns() const
+    {
+        int count = resultTitles.size();
+        for (const LineBean& lb: resultLineBeans)
+            if (!lb.ignore)
+                count = qMax(count, lb.regex.captureCount());
+        return count;
+    }
+
+    /// 关键词对应的命令行，%1、%2 替换为 key_exp 的捕获组；没有匹配的返回空，stream 为是否为流式搜索
+    CommandLine searchCmd(const QString& key, bool* stream = nullptr) const
+    {
+        for (const SearchType& type: searchTypes)
+        {
+            QRegularExpressionMatch match;
+            if (key.indexOf(type.keyRegex, 0, &match) < 0)
+                continue;
+            if (stream)
+                *stream = type.stream;
+            return type.command.fill(match.capturedTexts(), 1);
+        }
+        return CommandLine();
+    }
+
+    MyJson toJson() const
+    {
+        MyJson json;
+        if (!placeholder.isEmpty())
+            json.insert("placeholder", placeholder);
+        if (!source.isEmpty())
+            json.insert("source", source);
+
+        QJsonArray array;
+        for (auto type: searchTypes)
+            array.append(type.toJson());
+        json.insert("search_types", array);
+
+        array = QJsonArray();
+        for (int i = 0; i < resultTitles.size(); i++)
+        {
+            QString key = columnKeys.value(i);
+            int type = columnTypes.value(i, ResultQuery::StringColumn);
+            if (key.isEmpty() && type == ResultQuery::StringColumn)
+            {
+                array.append(resultTitles.at(i));
+                continue;
+            }
+            MyJson column;
+            column.insert("title", resultTitles.at(i));
+            if (!key.isEmpty())
+                column.insert("key", key);
+            if (type != ResultQuery::StringColumn)
+                column.insert("type", ResultQuery::columnTypeName(type));
+            array.append(column);
+        }
+        json.insert("result_titles", array);
+
+        array = QJsonArray();
+        for (auto line: resultLineBeans)
+            array.append(line.toJson());
+        json.insert("result_lines", array);
+
+        if (refreshTimer > 0)
+            json.insert("refresh_timer", refreshTimer);
+        if (timeoutMs > 0)
+            json.insert("timeout_ms", timeoutMs);
+        if (refreshKey >= 0 && refreshKey < resultTitles.size())
+            json.insert("refresh_key", resultTitles.at(refreshKey));
+        if (refreshHighlight)
+            json.insert("refresh_highlight", refreshHighlight);
+        if (!columnWidths.isEmpty())
+        {
+            array = QJsonArray();
+            for (int width: columnWidths)
+                array.append(width);
+            json.insert("column_widths", array);
+        }
+        if (streamMaxRows != 10000)
+            json.insert("stream_max_rows", streamMaxRows);
+        if (keyFilter == TextKeyFilter)
+            json.insert("key_filter", "text");
+        else if (keyFilter == RegexKeyFilter)
+            json.insert("key_filter", "regex");
+        return json;
+    }
+};
+
+#endif // MODEBEAN_H
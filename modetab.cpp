@@ -0,0 +1,683 @@
+#include <QTimer>
+#include <QMenu>
+#include <QScrollBar>
+#include "modetab.h"
+#include "ui_modetab.h"
+#include "fileutil.h"
+#include "searchrunner.h"
+#include "linematcher.h"
+#include "listhuntercore.h"
+#include "resultmodel.h"
+#include "nativesource.h"
+#include "refreshscheduler.h"
+
+ModeTab::ModeTab(MySettings *settings, int tabId, QWidget *parent)
+    : QWidget(parent),
+      ui(new Ui::ModeTab),
+      settings(settings),
+      tabId(tabId)
+{
+    ui->setupUi(this);
+    refreshScheduler = new RefreshScheduler(this);
+    refreshScheduler->setCpuBudget(settings->i("refresh/cpuBudget", 25));
+    connect(refreshScheduler, SIGNAL(refresh()), this, SLOT(refreshAndKeepSelection()));
+    resultModel = new ResultModel(this);
+    resultStore = new ResultStore;
+    refreshStore = new ResultStore;
+    snapshotStore = new ResultStore;
+    loadingStore = resultStore;
+    setMemoryLimit(settings->i("result/memoryLimit", 512));
+    resultModel->setStore(resultStore);
+    ui->resultTable->setModel(resultModel);
+    core = new ListHunterCore;
+    lineMatcher = core->matcher();
+    lineMatcher->setThreadCount(settings->i("search/matchThreads", 0));
+    searchRunner = new SearchRunner(this);
+    searchRunner->setTrace(&trace);
+    connect(searchRunner, SIGNAL(outputReady(quint64, const QString&)), this, SLOT(runnerOutput(quint64, const QString&)));
+    connect(searchRunner, SIGNAL(finished(quint64, bool, const QString&)), this, SLOT(runnerFinished(quint64, bool, const QString&)));
+    liveSearchTimer = new QTimer(this);
+    liveSearchTimer->setSingleShot(true);
+    connect(liveSearchTimer, SIGNAL(timeout()), this, SLOT(liveSearch()));
+    streamTimer = new QTimer(this);
+    streamTimer->setSingleShot(true);
+    streamTimer->setInterval(1000 / qBound(1, settings->i("stream/frameRate", 10), 60));
+    connect(streamTimer, SIGNAL(timeout()), this, SLOT(flushStream()));
+}
+
+ModeTab::~ModeTab()
+{
+    delete searchRunner; // 先结束进程，再释放结果
+    searchRunner = nullptr;
+    delete ui;
+    delete core;
+    delete resultStore;
+    delete refreshStore;
+    delete snapshotStore;
+}
+
+bool ModeTab::loadModeFile(QString path)
+{
+    QFileInfo info(path);
+    QString name = info.baseName();
+
+    // 优先使用 settings.ini 旁的模式缓存，JSON 没有变化时不再解码和解析
+    qint64 start = SearchTrace::now();
+    QStringList errors;
+    bool cached = false;
+    QString cacheDir = QFileInfo(settings->fileName()).absolutePath() + "/mode_cache";
+    if (!core->loadModeFileCached(path, cacheDir, &errors, &cached))
+    {
+        qCritical() << "加载模式文件失败：" << errors;
+        QMessageBox::critical(this, "加载模式失败", errors.join("\n"));
+        return false;
+    }
+    qInfo() << "load_mode:" << path << "cached:" << cached << "us:" << (SearchTrace::now() - start) / 1000;
+    modePath = path;
+    ui->searchEdit->setPlaceholderText(name);
+    applyMode();
+    return true;
+}
+
+void ModeTab::loadMode(MyJson json)
+{
+    QStringList errors;
+    if (!core->loadMode(json, &errors))
+    {
+        qCritical() << "模式正则表达式编译失败：" << errors;
+        QMessageBox::critical(this, "加载模式失败", "以下正则表达式无法编译：\n" + errors.join("\n"));
+        return ;
+    }
+    applyMode();
+}
+
+QString ModeTab::title() const
+{
+    if (modePath.isEmpty())
+        return "新标签页";
+    return QFileInfo(modePath).baseName();
+}
+
+/// core 中的模式加载成功后，重置界面和搜索状态
+void ModeTab::applyMode()
+{
+    mode = core->mode();
+
+    if (!mode.placeholder.isEmpty())
+        ui->searchEdit->setPlaceholderText(mode.placeholder);
+
+    searchRunner->cancel();
+    refreshScheduler->searchFinished(false);
+    refreshScheduler->setInterval(mode.refreshTimer);
+    refreshing = false;
+    loadingSnapshot = false;
+    snapshotValid = false;
+    streaming = false;
+    streamTimer->stop();
+    query = ResultQuery();
+    lastSearchCmd.clear();
+    ui->cancelButton->setEnabled(false);
+    ui->searchEdit->clear();
+    liveSearchTimer->stop();
+    resultModel->setTitles(mode.resultTitles);
+    resultStore->reset(mode.captureColumns());
+    resultModel->setStore(resultStore);
+}
+
+void ModeTab::saveModeFile(QString path)
+{
+    writeTextFile(path, mode.toJson().toBa());
+}
+
+/**
+ * 搜索关键词
+ * incremental 为 true 且命令与上次相同时，结果先写入 refreshStore，
+ * 结束后与当前结果对比，只更新变化的行
+ * 关键词中的列查询（state=LISTEN sort:-pid）分离出来，在缓存的结果上执行，只改查询时不再执行命令
+ * live 为边输入边搜索，关键词没有对应的命令时只在状态栏提示，不弹出对话框打断输入
+ */
+void ModeTab::search(QString key, bool incremental, bool live)
+{
+    QString text = key;
+    QString error;
+    ResultQuery parsed = ResultQuery::parse(text, mode.resultTitles, mode.columnKeys, mode.columnTypes, &key, &error);
+    if (!error.isEmpty())
+    {
+        showStatus("查询无效：" + error);
+        return ;
+    }
+    query = parsed;
+
+    // 进程内筛选：只执行空关键词对应的基础命令，关键词在缓存的结果上筛选
+    // 有查询时同样缓存命令的完整结果，查询变化时只重新筛选和排序
+    bool keyFilter = mode.keyFilter != ModeBean::NoKeyFilter && mode.source.isEmpty();
+    if (keyFilter || !query.isEmpty())
+    {
+        QString baseKey = keyFilter ? "" : key;
+        filterKey = keyFilter ? key : "";
+        if (snapshotValid && snapshotKey == baseKey && !incremental)
+        {
+            trace.begin("filter: " + text);
+            applyKeyFilter(false);
+            finishTrace();
+            return ;
+        }
+        if (loadingSnapshot && snapshotKey == baseKey && searchRunner->isRunning() && !incremental)
+            return ; // 基础命令还在读取，结束后按最新的关键词筛选
+        key = baseKey;
+        snapshotKey = baseKey;
+    }
+
+    if (!mode.source.isEmpty())
+    {
+        searchSource(key, incremental);
+        return ;
+    }
+
+    // 判断要执行的命令
+    bool stream = false;
+    CommandLine cmd = mode.searchCmd(key, &stream);
+    if (cmd.isEmpty())
+    {
+        if (live)
+        {
+            showStatus("[search_types]下没有满足关键词的搜索表达式");
+            return ;
+        }
+        qCritical() << "没有要执行的命令行";
+        QMessageBox::critical(this, "无法搜索", "找不和适合执行的命令行\n[search_types]下没有满足关键词的搜索表达式");
+        return ;
+    }
+    if (stream && !query.isEmpty())
+    {
+        showStatus("流式搜索不支持列查询");
+        return ;
+    }
+
+    // 设置表格；流式搜索总是重新开始，不与旧结果对比
+    prepareResult(cmd.text(), incremental && !stream);
+    streaming = stream;
+
+    // 执行命令行，输出在 appendResultOutput 中分批解析
+    qInfo() << "exec_cmd:" << cmd.text() << "direct:" << cmd.isDirect();
+    ui->cancelButton->setEnabled(true);
+    showStatus("正在搜索...");
+    searchGeneration = searchRunner->start(cmd, stream ? 0 : mode.timeoutMs);
+}
+
+/// 内置数据源直接生成结果列，不启动进程，也不需要正则
+void ModeTab::searchSource(QString key, bool incremental)
+{
+    searchRunner->cancel();
+    ResultStore* store = prepareResult(mode.source + " " + key, incremental);
+
+    QString error;
+    bool ok;
+    {
+        SearchTrace::Scope scope(&trace, SearchTrace::Read);
+        ok = NativeSource::read(mode.source, key, *store, &error);
+    }
+    {
+        SearchTrace::Scope scope(&trace, SearchTrace::Match);
+        lineMatcher->matchActionsInto(*store, 0);
+        store->spillIfNeeded();
+    }
+    resultLineCount = store->lineCount();
+    qInfo() << "read_source:" << mode.source << "rows:" << store->rowCount() << "us:" << trace.stageNs(SearchTrace::Read) / 1000;
+    if (!refreshing)
+    {
+        SearchTrace::Scope scope(&trace, SearchTrace::Model);
+        resultModel->syncRows();
+    }
+    searchFinished(ok, error);
+}
+
+/**
+ * 准备接收新的结果，返回写入的 store
+ * 增量刷新且命令不变时写入 refreshStore，否则清空表格
+ */
+ResultStore *ModeTab::prepareResult(const QString &cmd, bool incremental)
+{
+    trace.begin(cmd);
+    refreshScheduler->searchStarted();
+    streaming = false;
+    streamDropped = 0;
+    streamTimer->stop();
+    refreshing = incremental && cmd == lastSearchCmd && resultModel->rowCount() > 0;
+    lastSearchCmd = cmd;
+    resultLineCount = 0;
+    loadingSnapshot = (mode.keyFilter != ModeBean::NoKeyFilter && mode.source.isEmpty()) || !query.isEmpty();
+    if (loadingSnapshot)
+    {
+        // 基础命令的完整结果写入 snapshotStore，非刷新时表格先直接显示它
+        snapshotValid = false;
+        loadingStore = snapshotStore;
+        snapshotStore->reset(mode.captureColumns());
+        if (!refreshing)
+        {
+            resultModel->setTitles(mode.resultTitles);
+            resultStore->reset(mode.captureColumns());
+            resultModel->setStore(snapshotStore);
+        }
+    }
+    else if (refreshing)
+    {
+        loadingStore = refreshStore;
+        refreshStore->reset(mode.captureColumns());
+    }
+    else
+    {
+        loadingStore = resultStore;
+        resultModel->setTitles(mode.resultTitles);
+        resultStore->reset(mode.captureColumns());
+        resultModel->setStore(resultStore);
+    }
+    return loadingStore;
+}
+
+/**
+ * 在缓存的基础命令结果上按关键词筛选，再执行列查询
+ * 文本筛选在整块输出上查找子串，正则筛选使用只编译一次的关键词正则
+ */
+void ModeTab::applyKeyFilter(bool incremental)
+{
+    qint64 start = SearchTrace::now();
+    quint64 allocs = allocationCount();
+    QVector<int> rows;
+    if (mode.keyFilter == ModeBean::RegexKeyFilter && !filterKey.isEmpty())
+    {
+        QRegularExpression re(filterKey);
+        if (!re.isValid())
+        {
+            showStatus("关键词不是有效的正则表达式：" + re.errorString());
+            return ;
+        }
+        re.optimize();
+        rows = snapshotStore->rowsMatching(re);
+    }
+    else
+    {
+        rows = snapshotStore->rowsContaining(filterKey);
+    }
+    if (!query.isEmpty())
+        rows = query.apply(*snapshotStore, rows);
+    trace.addSpan(SearchTrace::Filter, start, SearchTrace::now(), allocationCount() - allocs);
+
+    SearchTrace::Scope scope(&trace, SearchTrace::Model);
+    if (incremental && resultModel->rowCount() > 0)
+    {
+        snapshotStore->subsetInto(rows, *refreshStore);
+        resultModel->applyStore(refreshStore, mode.refreshKey, mode.refreshHighlight);
+        qSwap(resultStore, refreshStore);
+        refreshStore->reset(mode.captureColumns()); // 保留容量，下一次刷新直接写入
+    }
+    else
+    {
+        resultModel->setTitles(mode.resultTitles);
+        snapshotStore->subsetInto(rows, *resultStore);
+        resultModel->setStore(resultStore);
+        resultModel->syncRows();
+    }
+    qInfo() << "filter_rows:" << rows.size() << "/" << snapshotStore->rowCount() << "us:" << (SearchTrace::now() - start) / 1000;
+    showStatus(QString("%1 / %2 行结果").arg(rows.size()).arg(snapshotStore->rowCount()));
+}
+
+/// 只接收当前这一代搜索的输出，被新搜索取代的旧结果直接丢弃
+void ModeTab::runnerOutput(quint64 generation, const QString &text)
+{
+    if (generation != searchGeneration)
+        return ;
+    appendResultOutput(text);
+}
+
+void ModeTab::runnerFinished(quint64 generation, bool ok, const QString &error)
+{
+    if (generation != searchGeneration)
+        return ;
+    searchFinished(ok, error);
+}
+
+/// 解析一批输出行，匹配到的行一次性追加到表格
+void ModeTab::appendResultOutput(const QString &text)
+{
+    ResultStore* store = loadingStore;
+    qint64 start = SearchTrace::now();
+    quint64 allocs = allocationCount();
+    int first = store->appendText(text);
+    int end = store->lineCount();
+    trace.addSpan(SearchTrace::Split, start, SearchTrace::now(), allocationCount() - allocs);
+    resultLineCount += end - first;
+    bool firstBatch = (store->rowCount() == 0);
+
+    // 匹配结果只记录偏移，追加到表格时不复制文本
+    start = SearchTrace::now();
+    allocs = allocationCount();
+    lineMatcher->matchInto(*store, first, end);
+    if (!streaming) // 流式搜索有行数上限，不写入临时文件
+        store->spillIfNeeded();
+    trace.addSpan(SearchTrace::Match, start, SearchTrace::now(), allocationCount() - allocs);
+    if (refreshing) // 刷新时等全部结束后再一起对比
+        return ;
+    if (streaming)
+    {
+        if (!streamTimer->isActive())
+            streamTimer->start();
+        return ;
+    }
+    start = SearchTrace::now();
+    allocs = allocationCount();
+    resultModel->syncRows();
+    trace.addSpan(SearchTrace::Model, start, SearchTrace::now(), allocationCount() - allocs);
+
+    // 第一批到达时先调整列宽，后续批次不再调整
+    if (firstBatch && resultModel->rowCount() > 0)
+    {
+        SearchTrace::Scope scope(&trace, SearchTrace::Resize);
+        resizeColumns();
+    }
+}
+
+void ModeTab::searchFinished(bool ok, const QString &error)
+{
+    qInfo() << "result_line_count:" << resultLineCount;
+    ui->cancelButton->setEnabled(false);
+    bool wasStreaming = streaming;
+    if (streaming)
+    {
+        flushStream();
+        streamTimer->stop();
+        streaming = false;
+    }
+    if (loadingSnapshot)
+    {
+        // 失败的刷新保留原来的表格；首次加载失败时仍筛选已读取的部分
+        loadingSnapshot = false;
+        snapshotValid = ok;
+        if (ok || !refreshing)
+            applyKeyFilter(refreshing);
+        refreshing = false;
+    }
+    else if (refreshing)
+    {
+        // 只有完整的结果才能对比，失败时保留原来的表格
+        refreshing = false;
+        if (ok)
+        {
+            SearchTrace::Scope scope(&trace, SearchTrace::Model);
+            resultModel->applyStore(refreshStore, mode.refreshKey, mode.refreshHighlight);
+            qSwap(resultStore, refreshStore);
+            refreshStore->reset(mode.captureColumns()); // 保留容量，下一次刷新直接写入
+        }
+    }
+    {
+        SearchTrace::Scope scope(&trace, SearchTrace::Resize);
+        resizeColumns();
+    }
+    QString msg = QString("%1 行结果").arg(resultModel->rowCount());
+    if (streamDropped > 0)
+        msg += QString("，已丢弃最早的 %1 行").arg(streamDropped);
+    if (!ok)
+        msg += "，" + error.trimmed();
+    showStatus(msg);
+    refreshScheduler->searchFinished(!wasStreaming); // 表格更新完后才开始等待下一次刷新；流式搜索的耗时不计入
+    finishTrace();
+}
+
+/**
+ * 流式搜索的输出随到随匹配，表格最多每帧更新一次（settings.ini 中 stream/frameRate，默认每秒 10 次）
+ * 超过 stream_max_rows 时丢弃最早的行，停在底部时跟随滚动
+ * 第一帧结束本次耗时统计，之后的批次不再记录，避免长时间运行的命令不断累积
+ */
+void ModeTab::flushStream()
+{
+    if (!streaming)
+        return ;
+    QScrollBar* bar = ui->resultTable->verticalScrollBar();
+    bool atBottom = bar->value() >= bar->maximum();
+    bool firstBatch = (resultModel->rowCount() == 0);
+
+    {
+        SearchTrace::Scope scope(&trace, SearchTrace::Model);
+        int excess = resultStore->rowCount() - mode.streamMaxRows;
+        if (mode.streamMaxRows > 0 && excess > 0)
+        {
+            resultModel->evictRows(resultStore, excess);
+            streamDropped += excess;
+        }
+        resultStore->compact(); // 没有匹配的行也不会一直占用内存
+        resultModel->syncRows();
+    }
+    if (firstBatch && resultModel->rowCount() > 0)
+    {
+        SearchTrace::Scope scope(&trace, SearchTrace::Resize);
+        resizeColumns();
+    }
+    if (atBottom)
+        ui->resultTable->scrollToBottom();
+
+    QString msg = QString("%1 行结果，持续接收中").arg(resultModel->rowCount());
+    if (streamDropped > 0)
+        msg += QString("，已丢弃最早的 %1 行").arg(streamDropped);
+    showStatus(msg);
+    finishTrace();
+}
+
+/**
+ * 按采样调整列宽，代替逐个测量所有单元格的 resizeColumnsToContents
+ * 只测量标题、前 sampleRows 行和匹配时记录的每列字符数最多的一行，自动宽度不超过 table/maxColumnWidth
+ * 模式中 column_widths 指定的列使用固定宽度
+ */
+void ModeTab::resizeColumns()
+{
+    const ResultStore* store = resultModel->currentStore();
+    if (!store)
+        return ;
+    QFontMetrics fm(ui->resultTable->font());
+    QHeaderView* header = ui->resultTable->horizontalHeader();
+    int maxWidth = settings->i("table/maxColumnWidth", 500);
+    int rows = qMin(resultModel->rowCount(), store->rowCount());
+    const int sampleRows = 100;
+    const int padding = 28; // 样式表中左右各 10px，加上网格线和文字边距
+
+    for (int c = 0; c < resultModel->columnCount() && c < store->columnCount(); c++)
+    {
+        if (c < mode.columnWidths.size() && mode.columnWidths.at(c) > 0)
+        {
+            ui->resultTable->setColumnWidth(c, mode.columnWidths.at(c));
+            continue;
+        }
+
+        int width = header->sectionSizeHint(c);
+        for (int r = 0; r < rows && r < sampleRows; r++)
+            width = qMax(width, fm.horizontalAdvance(store->cellRef(r, c).toString()) + padding);
+        int widest = store->widestRow(c);
+        if (widest >= 0 && widest < rows)
+            width = qMax(width, fm.horizontalAdvance(store->cellRef(widest, c).toString()) + padding);
+        ui->resultTable->setColumnWidth(c, qMin(width, maxWidth));
+    }
+}
+
+/// 结束本次搜索的计时，由主窗口加入历史记录并显示
+void ModeTab::finishTrace()
+{
+    if (!trace.isActive())
+        return ;
+    trace.end();
+    lastSummary = trace.summary();
+    qInfo() << "search_timing:" << lastSummary;
+    if (allocationCountAvailable())
+        qInfo() << "search_allocs:" << trace.totalAllocs() << "split:" << trace.stageAllocs(SearchTrace::Split)
+                << "match:" << trace.stageAllocs(SearchTrace::Match) << "model:" << trace.stageAllocs(SearchTrace::Model)
+                << "lines:" << resultLineCount;
+    emit searchTraced(trace);
+}
+
+void ModeTab::refreshAndKeepSelection()
+{
+    // 上一次刷新还没结束，跳过这一次
+    if (searchRunner->isRunning())
+        return ;
+
+    // 按 refresh_key 对比新旧结果，表格只收到增删改的信号，选中和滚动位置都会保留
+    search(ui->searchEdit->text(), true);
+}
+
+void ModeTab::on_searchButton_clicked()
+{
+    // 点击按钮总是重新执行命令，回车则优先使用缓存的结果筛选
+    snapshotValid = false;
+    search(ui->searchEdit->text());
+}
+
+void ModeTab::on_cancelButton_clicked()
+{
+    searchRunner->cancel();
+    refreshScheduler->searchFinished(false);
+    searchFinished(false, "已取消");
+}
+
+void ModeTab::on_searchEdit_returnPressed()
+{
+    liveSearchTimer->stop();
+    search(ui->searchEdit->text());
+}
+
+/// 边输入边搜索：停止输入一段时间后再搜索，旧关键词的命令立即取消
+void ModeTab::on_searchEdit_textChanged(const QString &)
+{
+    int delay = settings->i("search/liveDelay", 300);
+    if (delay <= 0)
+        return ;
+    if (searchRunner->isRunning() && !loadingSnapshot)
+    {
+        searchRunner->cancel();
+        refreshScheduler->searchFinished(false);
+        searchGeneration = 0;
+        refreshing = false;
+        ui->cancelButton->setEnabled(false);
+    }
+    liveSearchTimer->start(delay);
+}
+
+void ModeTab::liveSearch()
+{
+    search(ui->searchEdit->text(), false, true);
+}
+
+/**
+ * 右键菜单只使用搜索时记录的 LineBean 下标和动作位，不再执行正则
+ * 选中的行必须属于同一个 LineBean，菜单为所有行都可用的动作
+ */
+void ModeTab::on_resultTable_customContextMenuRequested(const QPoint&)
+{
+    auto rows = ui->resultTable->selectionModel()->selectedRows(0);
+    if (!rows.size())
+        return ;
+    refreshScheduler->postpone();
+
+    // 加载快照时表格显示的是 snapshotStore，行号要对应表格当前显示的结果
+    const ResultStore* store = resultModel->currentStore();
+    if (!store)
+        return ;
+    int row = rows.first().row();
+    if (row < 0 || row >= store->rowCount())
+        return ;
+    int bean = store->rowBean(row);
+    if (bean < 0 || bean >= mode.resultLineBeans.size())
+        return ;
+
+    quint64 usable = ~quint64(0);
+    for (auto ri: rows)
+    {
+        int r = ri.row();
+        if (r >= store->rowCount() || store->rowBean(r) != bean)
+            return ;
+        usable &= store->rowActions(r);
+    }
+
+    QMenu* menu = new QMenu;
+    const LineBean& lb = mode.resultLineBeans.at(bean);
+    for (int i = 0; i < lb.actions.size() && i < LineBean::maxActions; i++)
+    {
+        if (!(usable & (quint64(1) << i)))
+            continue;
+        const ActionBean& action = lb.actions.at(i);
+        QAction* act = new QAction(action.name, menu);
+
+        // 设置执行cmd
+        connect(act, &QAction::triggered, this, [=]{
+            // 菜单打开期间结果可能已经刷新，重新取表格当前的结果
+            const ResultStore* current = resultModel->currentStore();
+            if (!current)
+                return ;
+            QVector<QStringList> rowCaps;
+            for (auto ri: rows) // 遍历每一行
+            {
+                if (ri.row() < current->rowCount())
+                    rowCaps.append(ListHunterCore::actionCaptures(*current, ri.row(), lb, action));
+            }
+            emit actionsRequested(action.commands(rowCaps), action.refresh);
+        });
+
+        // 添加菜单
+        menu->addAction(act);
+    }
+
+    if (menu->actions().size() == 0)
+    {
+        delete menu;
+        return ;
+    }
+    menu->exec(QCursor::pos());
+    menu->deleteLater();
+}
+
+void ModeTab::on_resultTable_pressed(const QModelIndex &index)
+{
+    // 如果开了定时刷新，重新等待刷新延时
+    refreshScheduler->postpone();
+}
+
+/**
+ * 当前标签页按模式的 refresh_timer 刷新
+ * 后台标签页按 tabs/backgroundRefresh：0 为暂停（切换回来时立即刷新一次），N 为间隔放大 N 倍
+ */
+void ModeTab::setActive(bool active)
+{
+    refreshScheduler->setSlowdown(active ? 1 : settings->i("tabs/backgroundRefresh", 0));
+}
+
+/// 窗口最小化或隐藏时所有标签页都暂停刷新
+void ModeTab::setWindowVisible(bool visible)
+{
+    refreshScheduler->setPaused(!visible);
+}
+
+void ModeTab::setRefreshBudget(int percent)
+{
+    refreshScheduler->setCpuBudget(percent);
+}
+
+void ModeTab::setMemoryLimit(int mb)
+{
+    qint64 bytes = qint64(qMax(0, mb)) * 1024 * 1024;
+    resultStore->setMemoryBudget(bytes);
+    refreshStore->setMemoryBudget(bytes);
+    snapshotStore->setMemoryBudget(bytes);
+}
+
+void ModeTab::setMatchThreads(int count)
+{
+    lineMatcher->setThreadCount(count);
+}
+
+void ModeTab::refresh()
+{
+    search(ui->searchEdit->text(), true);
+}
+
+void ModeTab::showStatus(const QString &msg)
+{
+    status = msg;
+    emit statusChanged(msg);
+}
@@ -0,0 +1,127 @@
+#ifndef MODETAB_H
+#define MODETAB_H
+
+#include <QWidget>
+#include <QDebug>
+#include "mysettings.h"
+#include "myjson.h"
+#include "modebean.h"
+#include "resultstore.h"
+#include "searchtrace.h"
+
+namespace Ui { class ModeTab; }
+
+class SearchRunner;
+class LineMatcher;
+class ListHunterCore;
+class ResultModel;
+class RefreshScheduler;
+
+/**
+ * 一个标签页中打开的模式
+ * 每个标签页有自己的引擎、异步搜索和刷新定时器，互不影响
+ * 右键动作交给主窗口统一执行，状态和耗时也由主窗口显示
+ */
+class ModeTab : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit ModeTab(MySettings* settings, int tabId, QWidget *parent = nullptr);
+    ~ModeTab() override;
+
+    bool loadModeFile(QString path);
+    void saveModeFile(QString path);
+    QString modeFile() const { return modePath; }
+    QString title() const;
+    int id() const { return tabId; }
+
+    void setActive(bool active); // 是否为当前标签页，后台标签页按 tabs/backgroundRefresh 暂停或降低刷新频率
+    void setWindowVisible(bool visible);
+    void setMatchThreads(int count);
+    void setRefreshBudget(int percent); // 搜索耗时占刷新间隔的上限，超过时拉长间隔
+    void setMemoryLimit(int mb); // 每份结果在内存中的上限，超过后较早的行写入临时文件，0 为不限制
+    QString statusText() const { return status; }
+    QString traceSummary() const { return lastSummary; }
+
+signals:
+    void statusChanged(const QString& msg);
+    void actionsRequested(const QList<CommandLine>& cmds, bool refresh);
+    void searchTraced(const SearchTrace& trace);
+
+public slots:
+    void refresh(); // 保持选中行重新搜索，动作执行后调用
+
+private slots:
+    void loadMode(MyJson json);
+    void applyMode();
+    void search(QString key, bool incremental = false, bool live = false);
+    void searchSource(QString key, bool incremental);
+    void refreshAndKeepSelection();
+    void runnerOutput(quint64 generation, const QString& text);
+    void runnerFinished(quint64 generation, bool ok, const QString& error);
+    void appendResultOutput(const QString& text);
+    void searchFinished(bool ok, const QString& error);
+    void flushStream();
+
+private slots:
+    void on_searchButton_clicked();
+
+    void on_cancelButton_clicked();
+
+    void on_searchEdit_returnPressed();
+
+    void on_searchEdit_textChanged(const QString &);
+
+    void liveSearch();
+
+    void on_resultTable_customContextMenuRequested(const QPoint &);
+
+    void on_resultTable_pressed(const QModelIndex &index);
+
+private:
+    ResultStore* prepareResult(const QString& cmd, bool incremental);
+    void applyKeyFilter(bool incremental);
+    void resizeColumns();
+    void finishTrace();
+    void showStatus(const QString& msg);
+
+private:
+    Ui::ModeTab *ui;
+    MySettings* settings;
+    int tabId;
+    QString modePath;
+    QString status; // 切换回这个标签页时恢复状态栏
+
+    // 搜索变量
+    ResultStore* resultStore = nullptr; // 表格中显示的输出和每一行的结果
+    ResultStore* refreshStore = nullptr; // 增量刷新时正在读取的结果
+    ResultStore* snapshotStore = nullptr; // 进程内筛选时基础命令的完整结果
+    ResultStore* loadingStore = nullptr; // 正在写入输出的 store
+    bool refreshing = false; // 当前搜索是否为增量刷新
+    bool loadingSnapshot = false; // 当前搜索是否在读取基础命令
+    bool snapshotValid = false;
+    bool streaming = false; // 当前为流式搜索，命令持续运行
+    int streamDropped = 0; // 流式搜索超过 stream_max_rows 后丢弃的行数
+    QTimer* streamTimer = nullptr; // 流式搜索按帧率批量更新表格
+    QString filterKey; // 进程内筛选的关键词
+    QString snapshotKey; // snapshotStore 对应的命令关键词
+    ResultQuery query; // 关键词中的列查询，在 snapshotStore 上筛选和排序
+    QString lastSearchCmd;
+    int resultLineCount = 0; // 本次搜索读取到的总行数
+    ResultModel* resultModel = nullptr;
+    SearchRunner* searchRunner = nullptr;
+    quint64 searchGeneration = 0; // 当前有效的搜索代数，旧代数的输出会被丢弃
+    QTimer* liveSearchTimer = nullptr; // 边输入边搜索的防抖
+    ListHunterCore* core = nullptr; // 加载模式、匹配、展开动作命令
+    LineMatcher* lineMatcher = nullptr; // core 中的匹配器
+
+    // 耗时统计
+    SearchTrace trace; // 当前搜索
+    QString lastSummary;
+
+    ModeBean mode; // 当前加载的模式（core 中模式的副本），正则均已编译
+    RefreshScheduler* refreshScheduler = nullptr; // 按 refresh_timer 和搜索耗时安排下一次刷新
+};
+
+#endif // MODETAB_H
@@ -0,0 +1,428 @@
+#include <QHash>
+#include <QDebug>
+#include "nativesource.h"
+#include "resultquery.h"
+
+#if defined(Q_OS_LINUX)
+#include <dirent.h>
+#include <fcntl.h>
+#include <pwd.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <linux/netlink.h>
+#include <linux/sock_diag.h>
+#include <linux/inet_diag.h>
+#endif
+
+bool NativeSource::isSupported(const QString &source)
+{
+    return source == "proc:tasks" || source == "sock_diag:tcp" || source == "sock_diag:udp";
+}
+
+QStringList NativeSource::titles(const QString &source)
+{
+    if (source == "proc:tasks")
+        return QStringList{"UID", "PID", "PPID", "STAT", "TIME", "RSS", "CMD"};
+    if (source.startsWith("sock_diag:"))
+        return QStringList{"协议", "本地地址", "外部地址", "状态", "User", "Inode", "PID", "Program name"};
+    return QStringList();
+}
+
+QStringList NativeSource::columnKeys(const QString &source)
+{
+    if (source == "proc:tasks")
+        return QStringList{"uid", "pid", "ppid", "stat", "time", "rss", "cmd"};
+    if (source.startsWith("sock_diag:"))
+        return QStringList{"proto", "local", "foreign", "state", "user", "inode", "pid", "program"};
+    return QStringList();
+}
+
+QList<int> NativeSource::columnTypes(const QString &source)
+{
+    const int str = ResultQuery::StringColumn, num = ResultQuery::IntColumn, addr = ResultQuery::AddressColumn;
+    if (source == "proc:tasks")
+        return QList<int>{str, num, num, str, str, num, str};
+    if (source.startsWith("sock_diag:"))
+        return QList<int>{str, addr, addr, str, str, num, num, str};
+    return QList<int>();
+}
+
+bool NativeSource::read(const QString &source, const QString &key, ResultStore &store, QString *error)
+{
+#if defined(Q_OS_LINUX)
+    if (source == "proc:tasks")
+        return readTasks(key, store, error);
+    if (source == "sock_diag:tcp")
+        return readSockets(IPPROTO_TCP, key, store, error);
+    if (source == "sock_diag:udp")
+        return readSockets(IPPROTO_UDP, key, store, error);
+    if (error)
+        *error = "不支持的数据源：" + source;
+#else
+    Q_UNUSED(key)
+    Q_UNUSED(store)
+    if (error)
+        *error = "数据源 " + source + " 仅支持 Linux";
+#endif
+    return false;
+}
+
+#if defined(Q_OS_LINUX)
+
+/// 读取整个小文件到 buf，返回长度，失败返回 -1
+static int readSmallFile(const char* path, char* buf, int size)
+{
+    int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return -1;
+    int total = 0;
+    while (total < size - 1)
+    {
+        ssize_t n = ::read(fd, buf + total, size - 1 - total);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            break;
+        total += n;
+    }
+    ::close(fd);
+    buf[total] = 0;
+    return total;
+}
+
+static QString userName(uid_t uid)
+{
+    static QHash<uid_t, QString> names;
+    auto it = names.find(uid);
+    if (it != names.end())
+        return it.value();
+    passwd* pw = ::getpwuid(uid);
+    QString name = pw ? QString::fromLocal8Bit(pw->pw_name) : QString::number(uid);
+    names.insert(uid, name);
+    return name;
+}
+
+static bool isPidName(const char* name)
+{
+    if (!*name)
+        return false;
+    for (const char* p = name; *p; p++)
+        if (*p < '0' || *p > '9')
+            return false;
+    return true;
+}
+
+/// 和 ps 的 TIME 列一样：[天-]时:分:秒
+static QString cpuTime(unsigned long long ticks)
+{
+    static const long hz = ::sysconf(_SC_CLK_TCK);
+    unsigned long long secs = ticks / (hz > 0 ? hz : 100);
+    unsigned long long days = secs / 86400;
+    QString time = QString("%1:%2:%3")
+            .arg(secs / 3600 % 24, 2, 10, QChar('0'))
+            .arg(secs / 60 % 60, 2, 10, QChar('0'))
+            .arg(secs % 60, 2, 10, QChar('0'));
+    if (days)
+        time = QString::number(days) + "-" + time;
+    return time;
+}
+
+static bool rowContains(const QString* cells, int count, const QString& key)
+{
+    if (key.isEmpty())
+        return true;
+    for (int i = 0; i < count; i++)
+        if (cells[i].contains(key))
+            return true;
+    return false;
+}
+
+bool NativeSource::readTasks(const QString &key, ResultStore &store, QString *error)
+{
+    DIR* dir = ::opendir("/proc");
+    if (!dir)
+    {
+        if (error)
+            *error = QString("无法读取 /proc：") + ::strerror(errno);
+        return false;
+    }
+
+    static const long pageKb = ::sysconf(_SC_PAGESIZE) / 1024;
+    char path[64];
+    char buf[4096];
+    QString cells[7];
+    while (dirent* entry = ::readdir(dir))
+    {
+        if (!isPidName(entry->d_name))
+            continue;
+
+        // /proc/<pid>/stat：pid (comm) state ppid ... utime stime ... rss
+        snprintf(path, sizeof(path), "/proc/%s/stat", entry->d_name);
+        if (readSmallFile(path, buf, sizeof(buf)) <= 0)
+            continue; // 进程已经退出
+        char* commStart = strchr(buf, '(');
+        char* commEnd = strrchr(buf, ')'); // 进程名中可能有括号
+        if (!commStart || !commEnd || commEnd[1] == 0)
+            continue;
+        QString comm = QString::fromLocal8Bit(commStart + 1, int(commEnd - commStart - 1));
+        char state = commEnd[2];
+        unsigned long long fields[22] = {0}; // 第 4 到第 25 个字段
+        char* p = commEnd + 3;
+        for (int i = 0; i < 22 && *p; i++)
+            fields[i] = strtoull(p, &p, 10);
+        unsigned long long ppid = fields[0];
+        unsigned long long ticks = fields[10] + fields[11]; // utime + stime
+        unsigned long long rss = fields[20];
+
+        struct stat st;
+        snprintf(path, sizeof(path), "/proc/%s", entry->d_name);
+        uid_t uid = ::stat(path, &st) == 0 ? st.st_uid : 0;
+
+        // cmdline 中参数以 \0 分隔，内核线程为空
+        snprintf(path, sizeof(path), "/proc/%s/cmdline", entry->d_name);
+        int len = readSmallFile(path, buf, sizeof(buf));
+        QString cmd;
+        if (len > 0)
+        {
+            for (int i = 0; i < len; i++)
+                if (buf[i] == 0)
+                    buf[i] = ' ';
+            while (len > 0 && buf[len - 1] == ' ')
+                len--;
+            cmd = QString::fromLocal8Bit(buf, len);
+        }
+        else
+        {
+            cmd = "[" + comm + "]";
+        }
+
+        cells[0] = userName(uid);
+        cells[1] = QString::fromLatin1(entry->d_name);
+        cells[2] = QString::number(ppid);
+        cells[3] = QString(QChar::fromLatin1(state));
+        cells[4] = cpuTime(ticks);
+        cells[5] = QString::number(rss * pageKb);
+        cells[6] = cmd;
+        if (rowContains(cells, 7, key))
+            store.appendCells(cells, 7);
+    }
+    ::closedir(dir);
+    return true;
+}
+
+/// 扫描 /proc/*/fd，得到 socket inode 所属的进程
+static void scanSocketOwners(QHash<quint32, int>& owners)
+{
+    DIR* proc = ::opendir("/proc");
+    if (!proc)
+        return ;
+    char path[300];
+    char link[64];
+    while (dirent* entry = ::readdir(proc))
+    {
+        if (!isPidName(entry->d_name))
+            continue;
+        snprintf(path, sizeof(path), "/proc/%s/fd", entry->d_name);
+        DIR* fds = ::opendir(path);
+        if (!fds) // 没有权限读取其他用户的进程
+            continue;
+        int pid = atoi(entry->d_name);
+        while (dirent* fd = ::readdir(fds))
+        {
+            if (fd->d_name[0] == '.')
+                continue;
+            snprintf(path, sizeof(path), "/proc/%s/fd/%s", entry->d_name, fd->d_name);
+            ssize_t n = ::readlink(path, link, sizeof(link) - 1);
+            if (n <= 8 || strncmp(link, "socket:[", 8) != 0)
+                continue;
+            link[n] = 0;
+            owners.insert(quint32(strtoul(link + 8, nullptr, 10)), pid);
+        }
+        ::closedir(fds);
+    }
+    ::closedir(proc);
+}
+
+/**
+ * socket inode 所属的进程，在多次刷新之间缓存
+ * 扫描 /proc/*/fd 要对每个文件描述符 readlink，只有出现缓存中没有的 inode 时才重新扫描；
+ * 扫描后仍然找不到进程的 inode（其他用户的进程）记为 0，不会让之后的每次刷新都重新扫描
+ * 只在读取数据源的线程（界面线程或命令行主线程）中使用
+ */
+static const QHash<quint32, int>& socketOwners(const QList<inet_diag_msg>& sockets)
+{
+    static QHash<quint32, int> owners;
+    bool known = true;
+    for (const inet_diag_msg& msg: sockets)
+    {
+        if (msg.idiag_inode && !owners.contains(msg.idiag_inode))
+        {
+            known = false;
+            break;
+        }
+    }
+    if (known)
+        return owners;
+
+    owners.clear(); // 顺便丢掉已经关闭的 socket
+    scanSocketOwners(owners);
+    for (const inet_diag_msg& msg: sockets)
+    {
+        if (msg.idiag_inode && !owners.contains(msg.idiag_inode))
+            owners.insert(msg.idiag_inode, 0);
+    }
+    return owners;
+}
+
+static QString processName(int pid)
+{
+    char path[64];
+    char buf[256];
+    snprintf(path, sizeof(path), "/proc/%d/comm", pid);
+    int len = readSmallFile(path, buf, sizeof(buf));
+    while (len > 0 && buf[len - 1] == '\n')
+        len--;
+    return len > 0 ? QString::fromLocal8Bit(buf, len) : QString();
+}
+
+static QString socketAddress(int family, const __be32* addr, __be16 port, bool foreign)
+{
+    char text[INET6_ADDRSTRLEN] = {0};
+    ::inet_ntop(family, addr, text, sizeof(text));
+    quint16 p = ntohs(port);
+    return QString::fromLatin1(text) + ":" + (foreign && p == 0 ? QString("*") : QString::number(p));
+}
+
+static const char* tcpStateName(int state)
+{
+    static const char* names[] = {
+        "", "ESTABLISHED", "SYN_SENT", "SYN_RECV", "FIN_WAIT1", "FIN_WAIT2",
+        "TIME_WAIT", "CLOSE", "CLOSE_WAIT", "LAST_ACK", "LISTEN", "CLOSING"
+    };
+    return state > 0 && state < int(sizeof(names) / sizeof(names[0])) ? names[state] : "UNKNOWN";
+}
+
+/// 通过 NETLINK_SOCK_DIAG 一次性导出某个协议族的全部 socket
+static bool dumpSockets(int family, int protocol, QList<inet_diag_msg>& sockets, QString* error)
+{
+    int fd = ::socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_SOCK_DIAG);
+    if (fd < 0)
+    {
+        if (error)
+            *error = QString("无法创建 netlink socket：") + ::strerror(errno);
+        return false;
+    }
+
+    struct
+    {
+        nlmsghdr header;
+        inet_diag_req_v2 request;
+    } message;
+    memset(&message, 0, sizeof(message));
+    message.header.nlmsg_len = sizeof(message);
+    message.header.nlmsg_type = SOCK_DIAG_BY_FAMILY;
+    message.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    message.request.sdiag_family = quint8(family);
+    message.request.sdiag_protocol = quint8(protocol);
+    message.request.idiag_states = ~0U;
+
+    sockaddr_nl kernel;
+    memset(&kernel, 0, sizeof(kernel));
+    kernel.nl_family = AF_NETLINK;
+    if (::sendto(fd, &message, sizeof(message), 0, reinterpret_cast<sockaddr*>(&kernel), sizeof(kernel)) < 0)
+    {
+        if (error)
+            *error = QString("sock_diag 请求失败：") + ::strerror(errno);
+        ::close(fd);
+        return false;
+    }
+
+    bool ok = true;
+    bool done = false;
+    QByteArray buffer(65536, 0);
+    char* buf = buffer.data();
+    while (!done)
+    {
+        ssize_t received = ::recv(fd, buf, size_t(buffer.size()), 0);
+        if (received < 0 && errno == EINTR)
+            continue;
+        if (received <= 0)
+            break;
+        int len = int(received);
+        for (nlmsghdr* h = reinterpret_cast<nlmsghdr*>(buf); NLMSG_OK(h, len); h = NLMSG_NEXT(h, len))
+        {
+            if (h->nlmsg_type == NLMSG_DONE)
+            {
+                done = true;
+                break;
+            }
+            if (h->nlmsg_type == NLMSG_ERROR)
+            {
+                const nlmsgerr* err = static_cast<const nlmsgerr*>(NLMSG_DATA(h));
+                if (error)
+                    *error = QString("sock_diag 返回错误：") + ::strerror(-err->error);
+                ok = false;
+                done = true;
+                break;
+            }
+            sockets.append(*static_cast<const inet_diag_msg*>(NLMSG_DATA(h)));
+        }
+    }
+    ::close(fd);
+    return ok;
+}
+
+bool NativeSource::readSockets(int protocol, const QString &key, ResultStore &store, QString *error)
+{
+    QList<inet_diag_msg> sockets;
+    if (!dumpSockets(AF_INET, protocol, sockets, error))
+        return false;
+    int ipv4Count = sockets.size();
+    // 禁用了 IPv6 的系统（ipv6.disable=1、容器中没有 inet6 diag）只显示 IPv4 的连接
+    QString ipv6Error;
+    if (!dumpSockets(AF_INET6, protocol, sockets, &ipv6Error))
+    {
+        static bool warned = false;
+        if (!warned)
+        {
+            warned = true;
+            qWarning() << "无法读取 IPv6 连接，只显示 IPv4：" << ipv6Error;
+        }
+        sockets.erase(sockets.begin() + ipv4Count, sockets.end());
+    }
+    if (sockets.isEmpty())
+        return true;
+
+    const QHash<quint32, int>& owners = socketOwners(sockets);
+    QHash<int, QString> names;
+    bool tcp = (protocol == IPPROTO_TCP);
+    QString cells[8];
+    for (int i = 0; i < sockets.size(); i++)
+    {
+        const inet_diag_msg& msg = sockets.at(i);
+        int family = i < ipv4Count ? AF_INET : AF_INET6;
+        int pid = owners.value(msg.idiag_inode, 0);
+        if (pid && !names.contains(pid))
+            names.insert(pid, processName(pid));
+
+        cells[0] = QString(tcp ? "tcp" : "udp") + (family == AF_INET6 ? "6" : "");
+        cells[1] = socketAddress(family, msg.id.idiag_src, msg.id.idiag_sport, false);
+        cells[2] = socketAddress(family, msg.id.idiag_dst, msg.id.idiag_dport, true);
+        cells[3] = tcp ? QString::fromLatin1(tcpStateName(msg.idiag_state)) : QString();
+        cells[4] = userName(msg.idiag_uid);
+        cells[5] = QString::number(msg.idiag_inode);
+        cells[6] = pid ? QString::number(pid) : QString("-");
+        cells[7] = pid ? names.value(pid) : QString("-");
+        if (rowContains(cells, 8, key))
+            store.appendCells(cells, 8);
+    }
+    return true;
+}
+
+#endif
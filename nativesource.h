@@ -0,0 +1,31 @@
+#ifndef NATIVESOURCE_H
+#define NATIVESOURCE_H
+
+#include <QStringList>
+#include "resultstore.h"
+
+/**
+ * 内置数据源，不经过 shell 和正则，直接读取系统数据生成结果列
+ * 模式中使用 "source": "proc:tasks" 等代替 search_types
+ *
+ * proc:tasks      读取 /proc/<pid>/stat、cmdline，列同 ps
+ * sock_diag:tcp   通过 NETLINK_SOCK_DIAG 读取 TCP 连接，列同 netstat -pe
+ * sock_diag:udp   同上，UDP
+ */
+class NativeSource
+{
+public:
+    static bool isSupported(const QString& source);
+    static QStringList titles(const QString& source);
+    static QStringList columnKeys(const QString& source); // 查询中使用的英文列名
+    static QList<int> columnTypes(const QString& source); // ResultQuery::ColumnType
+
+    // 把数据源的每一行追加到 store，key 不为空时只保留包含 key 的行
+    static bool read(const QString& source, const QString& key, ResultStore& store, QString* error);
+
+private:
+    static bool readTasks(const QString& key, ResultStore& store, QString* error);
+    static bool readSockets(int protocol, const QString& key, ResultStore& store, QString* error);
+};
+
+#endif // NATIVESOURCE_H
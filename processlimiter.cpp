@@ -0,0 +1,34 @@
+#include "processlimiter.h"
+
+ProcessLimiter::ProcessLimiter(QObject *parent) : QObject(parent)
+{
+}
+
+ProcessLimiter *ProcessLimiter::instance()
+{
+    static ProcessLimiter limiter;
+    return &limiter;
+}
+
+void ProcessLimiter::setMaxProcesses(int count)
+{
+    maxCount = qMax(0, count);
+    if (maxCount == 0 || runningNum < maxCount)
+        emit available();
+}
+
+bool ProcessLimiter::acquire()
+{
+    if (maxCount > 0 && runningNum >= maxCount)
+        return false;
+    runningNum++;
+    return true;
+}
+
+void ProcessLimiter::release()
+{
+    if (runningNum <= 0)
+        return ;
+    runningNum--;
+    emit available();
+}
@@ -0,0 +1,35 @@
+#ifndef PROCESSLIMITER_H
+#define PROCESSLIMITER_H
+
+#include <QObject>
+
+/**
+ * 全局的子进程数量上限
+ * 所有标签页的搜索命令和右键动作共用，打开很多标签页时也不会同时启动太多进程
+ * 没有空位时调用方排队，等待 available 后再次 acquire
+ */
+class ProcessLimiter : public QObject
+{
+    Q_OBJECT
+public:
+    static ProcessLimiter* instance();
+
+    void setMaxProcesses(int count); // 0 为不限制
+    int maxProcesses() const { return maxCount; }
+    int runningCount() const { return runningNum; }
+
+    bool acquire(); // 有空位时占用一个并返回 true
+    void release();
+
+signals:
+    void available(); // 有空位了，排队的调用方重新 acquire
+
+private:
+    explicit ProcessLimiter(QObject *parent = nullptr);
+
+private:
+    int maxCount = 0;
+    int runningNum = 0;
+};
+
+#endif // PROCESSLIMITER_H
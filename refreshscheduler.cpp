@@ -0,0 +1,101 @@
+#include <QDebug>
+#include "refreshscheduler.h"
+#include "searchtrace.h"
+
+RefreshScheduler::RefreshScheduler(QObject *parent) : QObject(parent)
+{
+    timer = new QTimer(this);
+    timer->setSingleShot(true);
+    connect(timer, SIGNAL(timeout()), this, SIGNAL(refresh()));
+}
+
+void RefreshScheduler::setInterval(int ms)
+{
+    interval = qMax(0, ms);
+    cost = 0;
+    missed = false;
+    schedule();
+}
+
+void RefreshScheduler::setCpuBudget(int percent)
+{
+    budget = qBound(0, percent, 100);
+    if (timer->isActive())
+        schedule();
+}
+
+void RefreshScheduler::setSlowdown(int factor)
+{
+    bool wasPaused = isPaused();
+    slowdown = qMax(0, factor);
+    resume(wasPaused);
+}
+
+void RefreshScheduler::setPaused(bool paused)
+{
+    bool wasPaused = isPaused();
+    this->paused = paused;
+    resume(wasPaused);
+}
+
+void RefreshScheduler::postpone()
+{
+    if (timer->isActive())
+        schedule();
+}
+
+void RefreshScheduler::searchStarted()
+{
+    timer->stop();
+    running = true;
+    startTime = SearchTrace::now();
+}
+
+/// 耗时取滑动平均，偶尔一次慢不会让间隔忽长忽短
+void RefreshScheduler::searchFinished(bool measure)
+{
+    if (running && measure)
+    {
+        qint64 ms = (SearchTrace::now() - startTime) / 1000000;
+        cost = cost ? (cost * 3 + ms) / 4 : ms;
+        int next = nextInterval();
+        if (interval && next > interval * qMax(1, slowdown))
+            qInfo() << "refresh_backoff:" << "cost_ms:" << cost << "interval:" << next;
+    }
+    running = false;
+    schedule();
+}
+
+int RefreshScheduler::nextInterval() const
+{
+    qint64 ms = qint64(interval) * qMax(1, slowdown);
+    if (budget > 0 && cost > 0)
+        ms = qMax(ms, cost * 100 / budget);
+    return int(qMin<qint64>(ms, maxInterval));
+}
+
+/// 从暂停恢复时，如果错过了刷新就立即刷新一次，否则重新计时
+void RefreshScheduler::resume(bool wasPaused)
+{
+    if (wasPaused && !isPaused() && missed && !running)
+    {
+        missed = false;
+        timer->start(0);
+        return ;
+    }
+    if (wasPaused != isPaused() || timer->isActive())
+        schedule();
+}
+
+void RefreshScheduler::schedule()
+{
+    timer->stop();
+    if (!interval || running)
+        return ;
+    if (isPaused())
+    {
+        missed = true;
+        return ;
+    }
+    timer->start(nextInterval());
+}
@@ -0,0 +1,52 @@
+#ifndef REFRESHSCHEDULER_H
+#define REFRESHSCHEDULER_H
+
+#include <QObject>
+#include <QTimer>
+
+/**
+ * 定时刷新的调度
+ * 上一次搜索结束后才开始等待下一次，刷新之间不会重叠；
+ * 记录每次搜索的耗时，耗时超过间隔的 cpuBudget% 时拉长间隔；
+ * 窗口最小化、隐藏或标签页在后台时暂停，恢复时立即刷新一次
+ */
+class RefreshScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    explicit RefreshScheduler(QObject *parent = nullptr);
+
+    void setInterval(int ms); // 模式的 refresh_timer，0 为不刷新
+    void setCpuBudget(int percent); // 搜索耗时占间隔的上限，0 为不限制
+    void setSlowdown(int factor); // 间隔放大的倍数，0 为暂停（后台标签页）
+    void setPaused(bool paused); // 窗口最小化或隐藏
+
+    void postpone(); // 用户操作表格时重新等待完整的间隔
+    void searchStarted();
+    void searchFinished(bool measure = true); // 取消的搜索不计入耗时
+
+    bool isPaused() const { return paused || slowdown <= 0; }
+    int nextInterval() const; // 下一次刷新前等待的毫秒数
+    qint64 averageCost() const { return cost; } // 最近几次搜索的平均耗时（毫秒）
+
+signals:
+    void refresh();
+
+private:
+    void resume(bool wasPaused);
+    void schedule();
+
+private:
+    QTimer* timer;
+    int interval = 0;
+    int budget = 25;
+    int slowdown = 1;
+    bool paused = false;
+    bool running = false; // 搜索进行中，不计时
+    bool missed = false; // 暂停期间错过了刷新
+    qint64 startTime = 0;
+    qint64 cost = 0;
+    static const int maxInterval = 10 * 60 * 1000;
+};
+
+#endif // REFRESHSCHEDULER_H
@@ -0,0 +1,289 @@
+#include <QColor>
+#include <QHash>
+#include "resultmodel.h"
+
+ResultModel::ResultModel(QObject *parent) : QAbstractTableModel(parent)
+{
+}
+
+void ResultModel::setStore(const ResultStore *store)
+{
+    beginResetModel();
+    this->store = store;
+    rows = 0;
+    highlights.clear();
+    endResetModel();
+}
+
+/// 设置标题并清空表格，之后才能重置 store
+void ResultModel::setTitles(const QStringList &titles)
+{
+    beginResetModel();
+    this->titles = titles;
+    rows = 0;
+    highlights.clear();
+    endResetModel();
+}
+
+/// 批量追加，每批只发出一次插入信号
+void ResultModel::syncRows()
+{
+    int total = store ? store->rowCount() : 0;
+    if (total <= rows)
+        return ;
+
+    beginInsertRows(QModelIndex(), rows, total - 1);
+    rows = total;
+    if (!highlights.isEmpty())
+        highlights.resize(rows);
+    endInsertRows();
+}
+
+/// 表格中已经显示的行发出删除信号，还没有插入表格的行直接从 store 中删除
+void ResultModel::evictRows(ResultStore *target, int count)
+{
+    Q_ASSERT(target == store);
+    int shown = qMin(count, rows);
+    if (shown > 0)
+        beginRemoveRows(QModelIndex(), 0, shown - 1);
+    target->removeFirstRows(count);
+    rows -= shown;
+    if (!highlights.isEmpty())
+        highlights.remove(0, qMin(shown, highlights.size()));
+    if (shown > 0)
+        endRemoveRows();
+}
+
+/**
+ * 切换到新的结果，按 keyColumn 对比新旧行（-1 为整行）
+ * 只发出删除、插入、移动和 dataChanged 信号，视图的选中和滚动位置都会保留
+ * 调用期间旧 store 必须保持有效
+ * 有行写入了临时文件时结果很大，逐行对比需要的内存与结果行数成正比，直接重置表格
+ */
+void ResultModel::applyStore(const ResultStore *newStore, int keyColumn, bool highlight)
+{
+    if (store->spilledRowCount() > 0 || newStore->spilledRowCount() > 0)
+    {
+        beginResetModel();
+        store = newStore;
+        rows = newStore->rowCount();
+        highlights.clear();
+        endResetModel();
+        return ;
+    }
+
+    typedef QPair<QStringRef, int> RowKey; // 相同的 key 按出现次序区分
+    auto rowKeys = [=](const ResultStore* s, int count) {
+        QVector<RowKey> keys(count);
+        QHash<QStringRef, int> seen;
+        for (int r = 0; r < count; r++)
+        {
+            QStringRef key = rowKey(s, r, keyColumn);
+            keys[r] = RowKey(key, seen[key]++);
+        }
+        return keys;
+    };
+
+    const ResultStore* oldStore = store;
+    int newCount = newStore->rowCount();
+    QVector<RowKey> oldKeys = rowKeys(oldStore, rows);
+    QVector<RowKey> newKeys = rowKeys(newStore, newCount);
+    QHash<RowKey, int> newIndex;
+    newIndex.reserve(newCount);
+    for (int r = 0; r < newCount; r++)
+        newIndex.insert(newKeys.at(r), r);
+
+    // 过渡状态：每个表格行指向旧或新 store 中的一行
+    nextStore = newStore;
+    refs.resize(rows);
+    QVector<bool> hasOld(newCount, false);
+    for (int r = 0; r < rows; r++)
+    {
+        RowRef ref;
+        ref.fresh = false;
+        ref.row = r;
+        ref.target = newIndex.value(oldKeys.at(r), -1);
+        refs[r] = ref;
+        if (ref.target >= 0)
+            hasOld[ref.target] = true;
+    }
+
+    // 删除消失的行，从下往上按连续段删除
+    int r = refs.size() - 1;
+    while (r >= 0)
+    {
+        if (refs.at(r).target >= 0)
+        {
+            r--;
+            continue;
+        }
+        int last = r;
+        while (r >= 0 && refs.at(r).target < 0)
+            r--;
+        beginRemoveRows(QModelIndex(), r + 1, last);
+        refs.remove(r + 1, last - r);
+        rows = refs.size();
+        endRemoveRows();
+    }
+
+    // 按新结果的顺序依次插入或移动
+    QVector<bool> changed(newCount, false);
+    int moves = 0;
+    for (int i = 0; i < newCount; i++)
+    {
+        if (!hasOld.at(i))
+        {
+            int end = i;
+            while (end < newCount && !hasOld.at(end))
+                end++;
+            beginInsertRows(QModelIndex(), i, end - 1);
+            for (int k = i; k < end; k++)
+            {
+                RowRef ref;
+                ref.fresh = true;
+                ref.row = k;
+                ref.target = k;
+                refs.insert(k, ref);
+                changed[k] = true;
+            }
+            rows = refs.size();
+            endInsertRows();
+            i = end - 1;
+            continue;
+        }
+
+        if (refs.at(i).target != i)
+        {
+            if (++moves > maxMoves)
+            {
+                // 顺序几乎全变了，逐行移动不如直接重置
+                beginResetModel();
+                store = newStore;
+                nextStore = nullptr;
+                refs.clear();
+                rows = newCount;
+                highlights = highlight ? QVector<bool>(newCount, true) : QVector<bool>();
+                endResetModel();
+                return ;
+            }
+            int j = i + 1;
+            while (refs.at(j).target != i)
+                j++;
+            beginMoveRows(QModelIndex(), j, j, QModelIndex(), i);
+            RowRef ref = refs.at(j);
+            refs.remove(j);
+            refs.insert(i, ref);
+            endMoveRows();
+        }
+
+        changed[i] = oldStore->rowLineRef(refs.at(i).row) != newStore->rowLineRef(i);
+        RowRef& ref = refs[i];
+        ref.fresh = true;
+        ref.row = i;
+    }
+
+    // 全部指向新 store，结束过渡状态
+    store = newStore;
+    nextStore = nullptr;
+    refs.clear();
+    rows = newCount;
+
+    if (highlight)
+    {
+        highlights = changed;
+        if (rows && titles.size())
+            emit dataChanged(index(0, 0), index(rows - 1, titles.size() - 1));
+    }
+    else
+    {
+        highlights.clear();
+        emitRowsChanged(changed);
+    }
+}
+
+void ResultModel::clear()
+{
+    setTitles(titles);
+}
+
+QString ResultModel::cell(int row, int column) const
+{
+    if (row < 0 || row >= rows || column < 0 || column >= titles.size())
+        return QString();
+    const ResultStore* s = storeOf(row);
+    if (column >= s->columnCount())
+        return QString();
+    return s->cell(row, column);
+}
+
+int ResultModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : rows;
+}
+
+int ResultModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : titles.size();
+}
+
+QVariant ResultModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid())
+        return QVariant();
+    if (role == Qt::BackgroundRole)
+    {
+        if (index.row() < highlights.size() && highlights.at(index.row()))
+            return QColor(255, 244, 194);
+        return QVariant();
+    }
+    if (role != Qt::DisplayRole)
+        return QVariant();
+
+    int row = index.row();
+    const ResultStore* s = storeOf(row);
+    if (index.column() >= s->columnCount() || !s->hasCell(row, index.column()))
+        return QVariant();
+    return s->cell(row, index.column());
+}
+
+QVariant ResultModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation == Qt::Horizontal && role == Qt::DisplayRole && section >= 0 && section < titles.size())
+        return titles.at(section);
+    return QAbstractTableModel::headerData(section, orientation, role);
+}
+
+/// 表格行所在的 store，row 转换为 store 中的行
+const ResultStore *ResultModel::storeOf(int &row) const
+{
+    if (!nextStore)
+        return store;
+    const RowRef& ref = refs.at(row);
+    row = ref.row;
+    return ref.fresh ? nextStore : store;
+}
+
+QStringRef ResultModel::rowKey(const ResultStore *store, int row, int keyColumn)
+{
+    if (keyColumn < 0 || keyColumn >= store->columnCount())
+        return store->rowLineRef(row);
+    return store->cellRef(row, keyColumn);
+}
+
+/// 把变化的行按连续段发出 dataChanged
+void ResultModel::emitRowsChanged(const QVector<bool> &changed)
+{
+    int columns = titles.size();
+    if (!columns)
+        return ;
+    for (int i = 0; i < changed.size(); i++)
+    {
+        if (!changed.at(i))
+            continue;
+        int end = i;
+        while (end < changed.size() && changed.at(end))
+            end++;
+        emit dataChanged(index(i, 0), index(end - 1, columns - 1));
+        i = end;
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef RESULTMODEL_H
+#define RESULTMODEL_H
+
+#include <QAbstractTableModel>
+#include <QStringList>
+#include "resultstore.h"
+
+/**
+ * 搜索结果表格
+ * 直接读取 ResultStore 中按列存放的偏移和长度，
+ * 不再为每个单元格创建 QStandardItem，也不复制单元格文本
+ */
+class ResultModel : public QAbstractTableModel
+{
+    Q_OBJECT
+public:
+    explicit ResultModel(QObject *parent = nullptr);
+
+    void setStore(const ResultStore* store);
+    void setTitles(const QStringList& titles);
+    void syncRows(); // store 中新增的结果行一次性插入表格
+    void evictRows(ResultStore* target, int count); // 流式搜索：删除最前面的行，target 须为当前 store
+    void applyStore(const ResultStore* newStore, int keyColumn, bool highlight); // 与新结果对比，只更新变化的行
+    void clear();
+    const ResultStore* currentStore() const { return store; }
+
+    QString cell(int row, int column) const;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    struct RowRef
+    {
+        bool fresh; // 是否已指向新 store
+        int row; // 所在 store 中的行
+        int target; // 旧行对应的新行，-1 为将被删除
+    };
+
+    const ResultStore* storeOf(int& row) const;
+    static QStringRef rowKey(const ResultStore* store, int row, int keyColumn);
+    void emitRowsChanged(const QVector<bool>& changed);
+
+private:
+    const ResultStore* store = nullptr;
+    const ResultStore* nextStore = nullptr; // 仅在 applyStore 过程中有效
+    QVector<RowRef> refs; // 仅在 applyStore 过程中有效，表格行 -> 新旧 store 的行
+    QVector<bool> highlights; // 上一次刷新中新增或变化的行
+    QStringList titles;
+    int rows = 0; // 已经通知给视图的行数
+    static const int maxMoves = 256; // 行顺序变化太多时直接重置表格
+};
+
+#endif // RESULTMODEL_H
@@ -0,0 +1,326 @@
+#include <algorithm>
+#include <QRegularExpression>
+#include "resultquery.h"
+
+/// 保留满足条件的行，条件只读取预先解析好的列数组
+template <typename Pred>
+static QVector<int> keepRows(const QVector<int>& rows, Pred pred)
+{
+    QVector<int> result;
+    result.reserve(rows.size());
+    for (int r: rows)
+        if (pred(r))
+            result.append(r);
+    return result;
+}
+
+static bool matchOp(ResultQuery::Op op, int cmp)
+{
+    switch (op)
+    {
+    case ResultQuery::Equal: return cmp == 0;
+    case ResultQuery::NotEqual: return cmp != 0;
+    case ResultQuery::Less: return cmp < 0;
+    case ResultQuery::LessEqual: return cmp <= 0;
+    case ResultQuery::Greater: return cmp > 0;
+    case ResultQuery::GreaterEqual: return cmp >= 0;
+    default: return false;
+    }
+}
+
+/// IPv4 按数值、其他地址按文本比较，IPv4 排在前面；host、port 为 false 时不比较这一部分
+static int compareAddress(const AddressKey& a, const QStringRef& aText, const AddressKey& b, const QStringRef& bText,
+                          bool host, bool port)
+{
+    if (host)
+    {
+        if (a.host >= 0 && b.host >= 0)
+        {
+            if (a.host != b.host)
+                return a.host < b.host ? -1 : 1;
+        }
+        else if ((a.host >= 0) != (b.host >= 0))
+        {
+            return a.host >= 0 ? -1 : 1;
+        }
+        else
+        {
+            int cmp = aText.mid(a.hostSpan.start, a.hostSpan.length)
+                    .compare(bText.mid(b.hostSpan.start, b.hostSpan.length), Qt::CaseInsensitive);
+            if (cmp)
+                return cmp;
+        }
+    }
+    if (port && a.port != b.port)
+        return a.port < b.port ? -1 : 1;
+    return 0;
+}
+
+int ResultQuery::columnType(const QString &name)
+{
+    QString type = name.toLower();
+    if (type.isEmpty() || type == "string" || type == "text")
+        return StringColumn;
+    if (type == "int" || type == "number")
+        return IntColumn;
+    if (type == "ip:port" || type == "address")
+        return AddressColumn;
+    return -1;
+}
+
+QString ResultQuery::columnTypeName(int type)
+{
+    switch (type)
+    {
+    case IntColumn: return "int";
+    case AddressColumn: return "ip:port";
+    default: return "string";
+    }
+}
+
+ResultQuery ResultQuery::parse(const QString &text, const QStringList &titles, const QStringList &keys,
+                               const QList<int> &types, QString *rest, QString *error)
+{
+    ResultQuery query;
+    query.types = types;
+    while (query.types.size() < titles.size())
+        query.types.append(StringColumn);
+
+    QStringList restWords, queryWords;
+    for (const QString& word: text.split(' ', QString::SkipEmptyParts))
+    {
+        // sort:-rss,pid
+        if (word.startsWith("sort:", Qt::CaseInsensitive))
+        {
+            for (QString name: word.mid(5).split(',', QString::SkipEmptyParts))
+            {
+                SortKey key;
+                if (name.startsWith('-') || name.startsWith('+'))
+                {
+                    key.descending = name.startsWith('-');
+                    name.remove(0, 1);
+                }
+                key.column = findColumn(name, titles, keys);
+                if (key.column < 0)
+                {
+                    if (error)
+                        *error = "排序的列不存在：" + name;
+                    return ResultQuery();
+                }
+                query.sortKeys.append(key);
+            }
+            queryWords.append(word);
+            continue;
+        }
+
+        // 列 运算符 值，列名不存在时整个词仍作为关键词
+        int pos = word.indexOf(QRegularExpression("[=<>!~]"));
+        int column = pos > 0 ? findColumn(word.left(pos), titles, keys) : -1;
+        if (column < 0)
+        {
+            restWords.append(word);
+            continue;
+        }
+
+        // 两个字符的运算符在前
+        static const QList<QPair<QString, Op>> ops = {
+            {"!=", NotEqual}, {">=", GreaterEqual}, {"<=", LessEqual}, {"==", Equal},
+            {"=", Equal}, {">", Greater}, {"<", Less}, {"~", Contains}
+        };
+        Condition cond;
+        cond.column = column;
+        int opLength = 0;
+        for (const auto& op: ops)
+        {
+            if (word.midRef(pos).startsWith(op.first))
+            {
+                cond.op = op.second;
+                opLength = op.first.size();
+                break;
+            }
+        }
+        if (!opLength) // 单独的 !
+        {
+            restWords.append(word);
+            continue;
+        }
+        cond.text = word.mid(pos + opLength);
+
+        int type = query.types.value(column, StringColumn);
+        if (type == IntColumn && cond.op != Contains)
+        {
+            bool ok = false;
+            cond.number = cond.text.toLongLong(&ok);
+            if (!ok)
+            {
+                if (error)
+                    *error = QString("%1：%2 列为整数").arg(word).arg(titles.value(column));
+                return ResultQuery();
+            }
+        }
+        else if (type == AddressColumn && cond.op != Contains)
+        {
+            cond.address = AddressKey::parse(QStringRef(&cond.text));
+            cond.hasHost = cond.address.hostSpan.length > 0;
+            cond.hasPort = cond.text.contains(':');
+            if (!cond.address.valid)
+            {
+                if (error)
+                    *error = QString("%1：%2 列为 ip:port").arg(word).arg(titles.value(column));
+                return ResultQuery();
+            }
+        }
+        query.conditions.append(cond);
+        queryWords.append(word);
+    }
+
+    if (rest)
+        *rest = queryWords.isEmpty() ? text : restWords.join(' ');
+    query.source = queryWords.join(' ');
+    return query;
+}
+
+/// 按条件依次筛选，再稳定排序
+QVector<int> ResultQuery::apply(const ResultStore &store, QVector<int> rows) const
+{
+    for (const Condition& cond: conditions)
+    {
+        if (rows.isEmpty())
+            break;
+        rows = filter(store, rows, cond);
+    }
+    sort(store, rows);
+    return rows;
+}
+
+int ResultQuery::findColumn(const QString &name, const QStringList &titles, const QStringList &keys)
+{
+    if (name.isEmpty())
+        return -1;
+    for (int i = 0; i < titles.size(); i++)
+    {
+        if (titles.at(i).compare(name, Qt::CaseInsensitive) == 0
+                || (i < keys.size() && !keys.at(i).isEmpty() && keys.at(i).compare(name, Qt::CaseInsensitive) == 0))
+            return i;
+    }
+    bool ok = false;
+    int index = name.toInt(&ok) - 1; // 与 %1 一致，从 1 开始
+    if (ok && index >= 0 && index < titles.size())
+        return index;
+    return -1;
+}
+
+/**
+ * 整数列和地址列使用 ResultStore 缓存的整列数组比较，不再逐个解析单元格
+ * 解析失败或没有值的单元格不满足任何条件
+ */
+QVector<int> ResultQuery::filter(const ResultStore &store, const QVector<int> &rows, const Condition &cond) const
+{
+    int column = cond.column;
+    if (column >= store.columnCount())
+        return QVector<int>();
+
+    int type = types.value(column, StringColumn);
+    if (type == IntColumn && cond.op != Contains)
+    {
+        const qint64* v = store.numberColumn(column).constData();
+        const qint64 n = cond.number;
+        const qint64 missing = ResultStore::missingNumber;
+        switch (cond.op)
+        {
+        case Equal: return keepRows(rows, [=](int r) { return v[r] == n && v[r] != missing; });
+        case NotEqual: return keepRows(rows, [=](int r) { return v[r] != n && v[r] != missing; });
+        case Less: return keepRows(rows, [=](int r) { return v[r] < n && v[r] != missing; });
+        case LessEqual: return keepRows(rows, [=](int r) { return v[r] <= n && v[r] != missing; });
+        case Greater: return keepRows(rows, [=](int r) { return v[r] > n && v[r] != missing; });
+        case GreaterEqual: return keepRows(rows, [=](int r) { return v[r] >= n && v[r] != missing; });
+        default: return QVector<int>();
+        }
+    }
+
+    if (type == AddressColumn && cond.op != Contains)
+    {
+        const AddressKey* v = store.addressColumn(column).constData();
+        QStringRef condText(&cond.text);
+        return keepRows(rows, [&](int r) {
+            if (!v[r].valid)
+                return false;
+            return matchOp(cond.op, compareAddress(v[r], store.cellRef(r, column), cond.address, condText,
+                                                   cond.hasHost, cond.hasPort));
+        });
+    }
+
+    return keepRows(rows, [&](int r) {
+        if (!store.hasCell(r, column))
+            return false;
+        QStringRef cell = store.cellRef(r, column);
+        if (cond.op == Contains)
+            return cell.contains(cond.text, Qt::CaseInsensitive);
+        return matchOp(cond.op, cell.compare(cond.text, Qt::CaseInsensitive));
+    });
+}
+
+/// 多列稳定排序，没有值的单元格不论升降序都排在最后
+void ResultQuery::sort(const ResultStore &store, QVector<int> &rows) const
+{
+    if (sortKeys.isEmpty())
+        return ;
+
+    // 预先取出各排序列的数组，比较时不再查找缓存
+    struct SortColumn
+    {
+        int column;
+        int type;
+        bool descending;
+        const qint64* numbers;
+        const AddressKey* addresses;
+    };
+    QVector<SortColumn> keys;
+    for (const SortKey& key: sortKeys)
+    {
+        if (key.column >= store.columnCount())
+            continue;
+        SortColumn sc;
+        sc.column = key.column;
+        sc.type = types.value(key.column, StringColumn);
+        sc.descending = key.descending;
+        sc.numbers = sc.type == IntColumn ? store.numberColumn(key.column).constData() : nullptr;
+        sc.addresses = sc.type == AddressColumn ? store.addressColumn(key.column).constData() : nullptr;
+        keys.append(sc);
+    }
+
+    std::stable_sort(rows.begin(), rows.end(), [&](int a, int b) {
+        for (const SortColumn& key: keys)
+        {
+            int cmp = 0;
+            bool missA, missB;
+            if (key.numbers)
+            {
+                missA = key.numbers[a] == ResultStore::missingNumber;
+                missB = key.numbers[b] == ResultStore::missingNumber;
+                if (!missA && !missB && key.numbers[a] != key.numbers[b])
+                    cmp = key.numbers[a] < key.numbers[b] ? -1 : 1;
+            }
+            else if (key.addresses)
+            {
+                missA = !key.addresses[a].valid;
+                missB = !key.addresses[b].valid;
+                if (!missA && !missB)
+                    cmp = compareAddress(key.addresses[a], store.cellRef(a, key.column),
+                                         key.addresses[b], store.cellRef(b, key.column), true, true);
+            }
+            else
+            {
+                missA = !store.hasCell(a, key.column);
+                missB = !store.hasCell(b, key.column);
+                if (!missA && !missB)
+                    cmp = store.cellRef(a, key.column).compare(store.cellRef(b, key.column), Qt::CaseInsensitive);
+            }
+            if (missA != missB)
+                return missB;
+            if (cmp)
+                return key.descending ? cmp > 0 : cmp < 0;
+        }
+        return false;
+    });
+}
@@ -0,0 +1,77 @@
+#ifndef RESULTQUERY_H
+#define RESULTQUERY_H
+
+#include <QStringList>
+#include "resultstore.h"
+
+/**
+ * 在已经解析好的结果列上筛选和排序，不再执行命令
+ * 搜索框中的 列=值、列>值、sort:-列 等写法为查询，其余文字仍作为关键词：
+ *   state=LISTEN pid>1000 sort:-rss,pid
+ * 列可以是标题、result_titles 中的 key（均不区分大小写）或从 1 开始的列序号
+ * 比较按 result_titles 中声明的列类型（int、ip:port、string），排序稳定，可多列
+ */
+class ResultQuery
+{
+public:
+    enum ColumnType
+    {
+        StringColumn,
+        IntColumn,
+        AddressColumn
+    };
+
+    enum Op
+    {
+        Equal, // =
+        NotEqual, // !=
+        Less, // <
+        LessEqual, // <=
+        Greater, // >
+        GreaterEqual, // >=
+        Contains // ~，不区分大小写的子串
+    };
+
+    struct Condition
+    {
+        int column = -1;
+        Op op = Equal;
+        QString text;
+        qint64 number = 0;
+        AddressKey address;
+        bool hasHost = true; // ip:port 的值只写了 :port 时只比较端口
+        bool hasPort = true;
+    };
+
+    struct SortKey
+    {
+        int column = -1;
+        bool descending = false;
+    };
+
+    static int columnType(const QString& name); // JSON 中的类型名，未知时为 -1
+    static QString columnTypeName(int type);
+
+    /// 解析搜索框中的文字，不是查询的部分写入 rest；列名无效、值与类型不符时写入 error
+    static ResultQuery parse(const QString& text, const QStringList& titles, const QStringList& keys,
+                             const QList<int>& types, QString* rest, QString* error);
+
+    bool isEmpty() const { return conditions.isEmpty() && sortKeys.isEmpty(); }
+    QString toString() const { return source; }
+
+    /// 在 rows 中筛选并排序，返回结果行的顺序
+    QVector<int> apply(const ResultStore& store, QVector<int> rows) const;
+
+private:
+    static int findColumn(const QString& name, const QStringList& titles, const QStringList& keys);
+    QVector<int> filter(const ResultStore& store, const QVector<int>& rows, const Condition& cond) const;
+    void sort(const ResultStore& store, QVector<int>& rows) const;
+
+private:
+    QList<Condition> conditions;
+    QList<SortKey> sortKeys;
+    QList<int> types; // [列] ColumnType
+    QString source; // 查询部分的原文，用于比较查询是否变化
+};
+
+#endif // RESULTQUERY_H
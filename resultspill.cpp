@@ -0,0 +1,184 @@
+#include <cstring>
+#include <QDir>
+#include <QDebug>
+#include "resultspill.h"
+
+namespace
+{
+struct ChunkHeader
+{
+    qint32 rowCount;
+    qint32 columnCount;
+    qint32 actionCapCount;
+    qint32 textLength;
+};
+
+/// 每一段按 8 字节对齐，映射后可以直接按数组读取
+int aligned(qint64 bytes)
+{
+    return int((bytes + 7) & ~qint64(7));
+}
+
+void appendSection(QByteArray& data, const void* src, qint64 bytes)
+{
+    int pos = data.size();
+    data.resize(pos + aligned(bytes));
+    if (bytes > 0)
+        memcpy(data.data() + pos, src, size_t(bytes));
+    memset(data.data() + pos + bytes, 0, size_t(data.size() - pos - bytes));
+}
+}
+
+ResultSpill::ResultSpill() : file(QDir::tempPath() + "/listhunter-XXXXXX.rows")
+{
+}
+
+ResultSpill::~ResultSpill()
+{
+    file.close(); // 同时取消所有映射
+    qDeleteAll(chunks);
+}
+
+/**
+ * 块的格式：头部、[行] bean、[行] 动作位、[行] 动作捕获组起点、[行] 整行、[列][行] 单元格、动作捕获组、文本
+ * 只保留结果行的文本，被忽略和不匹配的行不写入；偏移改为相对块内文本
+ */
+bool ResultSpill::append(const ResultStore &store, int count)
+{
+    if (count <= 0)
+        return true;
+    if (!file.isOpen() && !file.open())
+    {
+        qWarning() << "无法创建结果临时文件：" << file.errorString();
+        return false;
+    }
+
+    int columns = store.columns.size();
+    int total = store.rowLines.size();
+
+    // 动作捕获组按行的顺序存放，这些行使用的是 [capBegin, capEnd)
+    int capBegin = -1, capEnd = store.actionCaps.size();
+    for (int r = 0; r < total; r++)
+    {
+        int offset = store.rowActionCaps.at(r);
+        if (offset < 0)
+            continue;
+        if (r < count && capBegin < 0)
+            capBegin = offset;
+        if (r >= count)
+        {
+            capEnd = offset;
+            break;
+        }
+    }
+    int capCount = capBegin < 0 ? 0 : capEnd - capBegin;
+
+    QString text;
+    QVector<qint32> beans(count);
+    QVector<qint32> capOffsets(count);
+    QVector<TextSpan> lines(count);
+    QVector<TextSpan> cells(columns * count);
+    QVector<TextSpan> caps(capCount);
+    QVector<int> lineShift(count); // 行在原文本和块内文本中的位置之差
+    for (int r = 0; r < count; r++)
+    {
+        const TextSpan& line = store.lines.at(store.rowLines.at(r));
+        lines[r].start = text.size();
+        lines[r].length = line.length;
+        lineShift[r] = line.start - text.size();
+        text += QStringRef(&store.buffer, line.start, line.length);
+        beans[r] = store.rowBeans.at(r);
+        capOffsets[r] = store.rowActionCaps.at(r) < 0 ? -1 : store.rowActionCaps.at(r) - capBegin;
+        for (int c = 0; c < columns; c++)
+        {
+            TextSpan span = store.columns.at(c).at(r);
+            if (span.start >= 0)
+                span.start -= lineShift.at(r);
+            cells[c * count + r] = span;
+        }
+    }
+    // 捕获组都在所属的行内，从后往前，每行的捕获组到下一个有捕获组的行为止
+    int capLimit = capCount;
+    for (int r = count - 1; r >= 0; r--)
+    {
+        int offset = capOffsets.at(r);
+        if (offset < 0)
+            continue;
+        for (int i = offset; i < capLimit; i++)
+        {
+            TextSpan span = store.actionCaps.at(capBegin + i);
+            if (span.start >= 0)
+                span.start -= lineShift.at(r);
+            caps[i] = span;
+        }
+        capLimit = offset;
+    }
+
+    ChunkHeader header;
+    header.rowCount = count;
+    header.columnCount = columns;
+    header.actionCapCount = capCount;
+    header.textLength = text.size();
+    QByteArray data;
+    appendSection(data, &header, sizeof(header));
+    appendSection(data, beans.constData(), qint64(count) * sizeof(qint32));
+    appendSection(data, store.rowActionBits.constData(), qint64(count) * sizeof(quint64));
+    appendSection(data, capOffsets.constData(), qint64(count) * sizeof(qint32));
+    appendSection(data, lines.constData(), qint64(count) * sizeof(TextSpan));
+    appendSection(data, cells.constData(), qint64(cells.size()) * sizeof(TextSpan));
+    appendSection(data, caps.constData(), qint64(capCount) * sizeof(TextSpan));
+    appendSection(data, text.constData(), qint64(text.size()) * sizeof(QChar));
+
+    if (file.write(data) != data.size() || !file.flush())
+    {
+        qWarning() << "无法写入结果临时文件：" << file.errorString();
+        file.resize(size);
+        file.seek(size);
+        return false;
+    }
+    uchar* p = file.map(size, data.size());
+    if (!p)
+    {
+        qWarning() << "无法映射结果临时文件：" << file.errorString();
+        file.resize(size);
+        file.seek(size);
+        return false;
+    }
+    size += data.size();
+
+    // 与写入时相同的布局
+    Chunk* chunk = new Chunk;
+    chunk->firstRow = store.spilledRows;
+    chunk->rowCount = count;
+    chunk->actionCapCount = capCount;
+    p += aligned(sizeof(ChunkHeader));
+    chunk->beans = reinterpret_cast<const qint32*>(p);
+    p += aligned(qint64(count) * sizeof(qint32));
+    chunk->actions = reinterpret_cast<const quint64*>(p);
+    p += aligned(qint64(count) * sizeof(quint64));
+    chunk->actionCapOffsets = reinterpret_cast<const qint32*>(p);
+    p += aligned(qint64(count) * sizeof(qint32));
+    chunk->lines = reinterpret_cast<const TextSpan*>(p);
+    p += aligned(qint64(count) * sizeof(TextSpan));
+    chunk->cells = reinterpret_cast<const TextSpan*>(p);
+    p += aligned(qint64(cells.size()) * sizeof(TextSpan));
+    chunk->actionCaps = reinterpret_cast<const TextSpan*>(p);
+    p += aligned(qint64(capCount) * sizeof(TextSpan));
+    chunk->text = QString::fromRawData(reinterpret_cast<const QChar*>(p), text.size());
+    chunks.append(chunk);
+    return true;
+}
+
+const ResultSpill::Chunk *ResultSpill::chunk(int row) const
+{
+    int lo = 0, hi = chunks.size() - 1;
+    while (lo < hi)
+    {
+        int mid = (lo + hi + 1) / 2;
+        if (chunks.at(mid)->firstRow <= row)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+    return chunks.at(lo);
+}
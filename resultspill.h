@@ -0,0 +1,45 @@
+#ifndef RESULTSPILL_H
+#define RESULTSPILL_H
+
+#include <QTemporaryFile>
+#include <QVector>
+#include "resultstore.h"
+
+/**
+ * 超出内存预算后写入临时文件的结果行
+ * 每次写入的一批行为一块，块内是紧凑的二进制行格式（数组 + UTF-16 文本），
+ * 写入后映射回内存直接读取，不解析也不复制；页面由系统按需读入，内存紧张时可以直接丢弃，
+ * 因此常驻内存不随结果行数增长。返回的 QStringRef 在 ResultSpill 销毁前一直有效
+ */
+class ResultSpill
+{
+public:
+    struct Chunk
+    {
+        int firstRow = 0; // 块中第一行在整个结果中的行号
+        int rowCount = 0;
+        const qint32* beans = nullptr; // [行]
+        const quint64* actions = nullptr; // [行]
+        const qint32* actionCapOffsets = nullptr; // [行] 在 actionCaps 中的起点，-1 为没有
+        const TextSpan* lines = nullptr; // [行] 整行在 text 中的位置
+        const TextSpan* cells = nullptr; // [列 * rowCount + 行]
+        const TextSpan* actionCaps = nullptr;
+        int actionCapCount = 0;
+        QString text; // 指向映射的内存，不持有数据
+    };
+
+    ResultSpill();
+    ~ResultSpill();
+
+    bool append(const ResultStore& store, int count); // 写入 store 内存中最前面的 count 行
+    const Chunk* chunk(int row) const; // row 所在的块
+    const QVector<Chunk*>& chunkList() const { return chunks; }
+    qint64 fileSize() const { return size; }
+
+private:
+    QTemporaryFile file;
+    QVector<Chunk*> chunks;
+    qint64 size = 0;
+};
+
+#endif // RESULTSPILL_H
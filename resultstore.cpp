@@ -0,0 +1,637 @@
+#include <limits>
+#include <QDebug>
+#include "resultstore.h"
+#include "resultspill.h"
+
+const qint64 ResultStore::missingNumber = std::numeric_limits<qint64>::min();
+
+namespace
+{
+QStringRef chunkRef(const ResultSpill::Chunk* chunk, const TextSpan& span)
+{
+    if (span.start < 0)
+        return QStringRef();
+    return QStringRef(&chunk->text, span.start, span.length);
+}
+
+/**
+ * 清空但保留容量，重置后相当于下一次搜索的 arena：文本、行和单元格偏移都写入已有的内存，
+ * 定时刷新稳定后每次搜索不再为这些数组分配内存，也不用逐个释放
+ * 容量远大于这次实际使用的大小时释放，一次很大的结果之后不会一直占用
+ */
+template<typename Container>
+void rewind(Container& c)
+{
+    if (c.capacity() > 4 * qMax(c.size(), 4096))
+        c = Container();
+    else
+        c.resize(0);
+}
+}
+
+void ResultStore::reset(int columnCount)
+{
+    rewind(buffer);
+    rewind(lines);
+    rewind(rowLines);
+    rewind(rowBeans);
+    if (columns.size() != columnCount)
+        columns = QVector<QVector<TextSpan>>(columnCount);
+    for (QVector<TextSpan>& column: columns)
+        rewind(column);
+    widestRows.fill(-1, columnCount);
+    rewind(rowActionBits);
+    rewind(rowActionCaps);
+    rewind(actionCaps);
+    clearTypedColumns();
+    spilledRows = 0;
+    spill.reset();
+    spillFailed = false;
+}
+
+/// 只计算随结果增长的部分，不含 QVector 预留的容量
+qint64 ResultStore::memoryUsage() const
+{
+    qint64 rows = rowLines.size();
+    return qint64(buffer.size()) * qint64(sizeof(QChar))
+            + qint64(lines.size() + actionCaps.size()) * qint64(sizeof(TextSpan))
+            + rows * qint64(3 * sizeof(int) + sizeof(quint64) + columns.size() * sizeof(TextSpan));
+}
+
+/**
+ * 超出内存预算时，把内存中最早的结果行写入临时文件，降到预算的一半，写入的频率与结果大小无关
+ * 行号不变，表格不需要更新；写入后截掉这些行和之前被忽略的行的文本
+ * 没有结果行时也会截掉已经匹配过的输出，不匹配的输出不会一直占用内存
+ */
+bool ResultStore::spillIfNeeded()
+{
+    if (memoryBudget <= 0 || spillFailed)
+        return false;
+    qint64 used = memoryUsage();
+    if (used <= memoryBudget)
+        return false;
+
+    int count = int(rowLines.size() - rowLines.size() * (memoryBudget / 2) / used);
+    if (count > 0)
+    {
+        if (!spill)
+            spill.reset(new ResultSpill);
+        if (!spill->append(*this, count))
+        {
+            spillFailed = true; // 结果仍然全部保留在内存中
+            return false;
+        }
+        rowLines.remove(0, count);
+        rowBeans.remove(0, count);
+        rowActionBits.remove(0, count);
+        rowActionCaps.remove(0, count);
+        for (QVector<TextSpan>& column: columns)
+            column.remove(0, count);
+        spilledRows += count;
+    }
+    dropUnusedText();
+    qInfo() << "spill_rows:" << count << "spilled_rows:" << spilledRows
+            << "file_bytes:" << (spill ? spill->fileSize() : 0) << "memory_bytes:" << memoryUsage();
+    return true;
+}
+
+/// 按 \r、\n 切分，连续的换行视为一个，与之前 split("[\\r\\n]+", SkipEmptyParts) 一致
+int ResultStore::appendText(const QString &text)
+{
+    int first = lines.size();
+    int base = buffer.size();
+    buffer += text;
+
+    const QChar* data = buffer.constData();
+    int end = buffer.size();
+    int lineStart = base;
+    for (int i = base; i <= end; i++)
+    {
+        if (i < end && data[i] != '\n' && data[i] != '\r')
+            continue;
+        if (i > lineStart)
+        {
+            TextSpan span;
+            span.start = lineStart;
+            span.length = i - lineStart;
+            lines.append(span);
+        }
+        lineStart = i + 1;
+    }
+    return first;
+}
+
+QStringRef ResultStore::lineRef(int line) const
+{
+    return spanRef(lines.at(line));
+}
+
+void ResultStore::appendRow(int line, int bean, const TextSpan *caps)
+{
+    rowLines.append(line);
+    rowBeans.append(bean);
+    rowActionBits.append(~quint64(0));
+    rowActionCaps.append(-1);
+    clearTypedColumns();
+    for (int c = 0; c < columns.size(); c++)
+    {
+        columns[c].append(caps[c]);
+        updateWidest(rowCount() - 1, c, caps[c]);
+    }
+}
+
+int ResultStore::rowBean(int row) const
+{
+    if (row < spilledRows)
+    {
+        const ResultSpill::Chunk* chunk = spill->chunk(row);
+        return chunk->beans[row - chunk->firstRow];
+    }
+    return rowBeans.at(row - spilledRows);
+}
+
+/// 只能设置还在内存中的行
+void ResultStore::setRowActions(int row, quint64 actions, const TextSpan *caps, int count)
+{
+    Q_ASSERT(row >= spilledRows);
+    row -= spilledRows;
+    rowActionBits[row] = actions;
+    if (count <= 0)
+    {
+        rowActionCaps[row] = -1;
+        return ;
+    }
+    rowActionCaps[row] = actionCaps.size();
+    for (int i = 0; i < count; i++)
+        actionCaps.append(caps[i]);
+}
+
+quint64 ResultStore::rowActions(int row) const
+{
+    if (row < spilledRows)
+    {
+        const ResultSpill::Chunk* chunk = spill->chunk(row);
+        return chunk->actions[row - chunk->firstRow];
+    }
+    return rowActionBits.at(row - spilledRows);
+}
+
+QStringRef ResultStore::actionCapRef(int row, int index) const
+{
+    if (index < 0)
+        return QStringRef();
+    if (row < spilledRows)
+    {
+        const ResultSpill::Chunk* chunk = spill->chunk(row);
+        int offset = chunk->actionCapOffsets[row - chunk->firstRow];
+        return offset < 0 ? QStringRef() : chunkRef(chunk, chunk->actionCaps[offset + index]);
+    }
+    int offset = rowActionCaps.at(row - spilledRows);
+    if (offset < 0)
+        return QStringRef();
+    return spanRef(actionCaps.at(offset + index));
+}
+
+/// 各列以 \t 连接成一行写入文本，单元格指向其中的片段
+void ResultStore::appendCells(const QString *cells, int count, int bean)
+{
+    TextSpan line;
+    line.start = buffer.size();
+    rowLines.append(lines.size());
+    rowBeans.append(bean);
+    rowActionBits.append(~quint64(0));
+    rowActionCaps.append(-1);
+    clearTypedColumns();
+    for (int c = 0; c < columns.size(); c++)
+    {
+        TextSpan span;
+        if (c < count)
+        {
+            if (c > 0)
+                buffer += '\t';
+            span.start = buffer.size();
+            span.length = cells[c].size();
+            buffer += cells[c];
+        }
+        columns[c].append(span);
+        updateWidest(rowCount() - 1, c, span);
+    }
+    line.length = buffer.size() - line.start;
+    buffer += '\n';
+    lines.append(line);
+}
+
+/**
+ * 各行的偏移数组整体前移，文本在 compact 中再截掉
+ * 被删除的行如果是某列最宽的行，这一列的最宽行变为未知
+ */
+void ResultStore::removeFirstRows(int count)
+{
+    Q_ASSERT(!spilledRows);
+    count = qMin(count, rowCount());
+    if (count <= 0)
+        return ;
+    rowLines.remove(0, count);
+    rowBeans.remove(0, count);
+    rowActionBits.remove(0, count);
+    rowActionCaps.remove(0, count);
+    for (QVector<TextSpan>& column: columns)
+        column.remove(0, count);
+    for (int& widest: widestRows)
+        widest = widest >= count ? widest - count : -1;
+    clearTypedColumns();
+    compact();
+}
+
+/**
+ * 第一个结果行之前的文本、行和动作捕获组都不再使用
+ * 这一部分超过一半时才整体前移并修正偏移，均摊到每行为常数时间
+ */
+void ResultStore::compact()
+{
+    int firstLine = rowLines.isEmpty() ? lines.size() : rowLines.first();
+    int cut = firstLine < lines.size() ? lines.at(firstLine).start : buffer.size();
+    if (cut <= 0 || cut < buffer.size() / 2)
+        return ;
+    dropUnusedText();
+}
+
+void ResultStore::dropUnusedText()
+{
+    int firstLine = rowLines.isEmpty() ? lines.size() : rowLines.first();
+    int cut = firstLine < lines.size() ? lines.at(firstLine).start : buffer.size();
+    if (cut <= 0)
+        return ;
+
+    buffer.remove(0, cut);
+    lines.remove(0, firstLine);
+    for (TextSpan& span: lines)
+        span.start -= cut;
+    for (int& line: rowLines)
+        line -= firstLine;
+    for (QVector<TextSpan>& column: columns)
+        for (TextSpan& span: column)
+            if (span.start >= 0)
+                span.start -= cut;
+
+    // 动作捕获组按行的顺序追加，第一个仍在使用的之前都可以丢弃
+    int firstCap = actionCaps.size();
+    for (int offset: rowActionCaps)
+    {
+        if (offset >= 0)
+        {
+            firstCap = offset;
+            break;
+        }
+    }
+    actionCaps.remove(0, firstCap);
+    for (TextSpan& span: actionCaps)
+        if (span.start >= 0)
+            span.start -= cut;
+    for (int& offset: rowActionCaps)
+        if (offset >= 0)
+            offset -= firstCap;
+}
+
+QStringRef ResultStore::rowLineRef(int row) const
+{
+    if (row < spilledRows)
+    {
+        const ResultSpill::Chunk* chunk = spill->chunk(row);
+        return chunkRef(chunk, chunk->lines[row - chunk->firstRow]);
+    }
+    return lineRef(rowLines.at(row - spilledRows));
+}
+
+QString ResultStore::rowLine(int row) const
+{
+    return rowLineRef(row).toString();
+}
+
+QStringRef ResultStore::cellRef(int row, int column) const
+{
+    if (row < spilledRows)
+    {
+        const ResultSpill::Chunk* chunk = spill->chunk(row);
+        return chunkRef(chunk, chunk->cells[column * chunk->rowCount + row - chunk->firstRow]);
+    }
+    return spanRef(columns.at(column).at(row - spilledRows));
+}
+
+QString ResultStore::cell(int row, int column) const
+{
+    return cellRef(row, column).toString();
+}
+
+bool ResultStore::hasCell(int row, int column) const
+{
+    return cellSpan(row, column).start >= 0;
+}
+
+TextSpan ResultStore::cellSpan(int row, int column) const
+{
+    if (row < spilledRows)
+    {
+        const ResultSpill::Chunk* chunk = spill->chunk(row);
+        return chunk->cells[column * chunk->rowCount + row - chunk->firstRow];
+    }
+    return columns.at(column).at(row - spilledRows);
+}
+
+namespace
+{
+/**
+ * 在整块文本上查找 key（QString::indexOf 内部按 SIMD 扫描），
+ * 命中位置二分映射到结果行，每行命中后直接跳到行尾继续
+ * rowSpan(r) 为第 r 行在 text 中的位置，按 r 递增；找到的行加上 base 后追加到 result
+ */
+template<typename RowSpan>
+void findRows(const QString& text, int rows, RowSpan rowSpan, const QString& key, int base, QVector<int>& result)
+{
+    int row = 0;
+    int pos = text.indexOf(key);
+    while (pos >= 0 && row < rows)
+    {
+        // 第一个行尾在命中位置之后的结果行
+        int lo = row, hi = rows;
+        while (lo < hi)
+        {
+            int mid = (lo + hi) / 2;
+            TextSpan span = rowSpan(mid);
+            if (span.start + span.length <= pos)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        row = lo;
+        if (row >= rows)
+            break;
+
+        TextSpan span = rowSpan(row);
+        if (pos < span.start) // 命中在被忽略或不匹配的行中
+        {
+            pos = text.indexOf(key, span.start);
+            continue;
+        }
+        if (pos + key.size() <= span.start + span.length)
+        {
+            result.append(base + row);
+            pos = text.indexOf(key, span.start + span.length);
+            row++;
+            continue;
+        }
+        pos = text.indexOf(key, pos + 1); // 跨行的命中
+    }
+}
+}
+
+/// 临时文件中的行逐块在映射的文本上查找，之后是内存中的行
+QVector<int> ResultStore::rowsContaining(const QString &key) const
+{
+    QVector<int> result;
+    int rows = rowCount();
+    if (key.isEmpty())
+    {
+        result.resize(rows);
+        for (int r = 0; r < rows; r++)
+            result[r] = r;
+        return result;
+    }
+
+    if (spill)
+    {
+        for (const ResultSpill::Chunk* chunk: spill->chunkList())
+            findRows(chunk->text, chunk->rowCount, [chunk](int r) { return chunk->lines[r]; }, key, chunk->firstRow, result);
+    }
+    findRows(buffer, rowLines.size(), [this](int r) { return lines.at(rowLines.at(r)); }, key, spilledRows, result);
+    return result;
+}
+
+QVector<int> ResultStore::rowsMatching(const QRegularExpression &re) const
+{
+    QVector<int> result;
+    for (int r = 0; r < rowCount(); r++)
+        if (re.match(rowLineRef(r)).hasMatch())
+            result.append(r);
+    return result;
+}
+
+/**
+ * 复制选中行的偏移，文本通过隐式共享不会复制
+ * 有写入临时文件的行时逐行复制文本，结果超出内存预算时同样写入临时文件
+ */
+ResultStore ResultStore::subset(const QVector<int> &rows) const
+{
+    ResultStore store;
+    store.memoryBudget = memoryBudget;
+    subsetInto(rows, store);
+    return store;
+}
+
+/// 清空 store 后写入指定的行，store 保留自己的内存预算和已经分配的数组
+void ResultStore::subsetInto(const QVector<int> &rows, ResultStore &store) const
+{
+    store.reset(columns.size());
+    if (spilledRows > 0)
+    {
+        for (int i = 0; i < rows.size(); i++)
+        {
+            store.appendRowFrom(*this, rows.at(i));
+            if ((i & 4095) == 4095)
+                store.spillIfNeeded();
+        }
+        store.spillIfNeeded();
+        return ;
+    }
+
+    store.buffer = buffer;
+    store.lines.reserve(rows.size());
+    store.rowLines.reserve(rows.size());
+    store.rowBeans.reserve(rows.size());
+    store.rowActionBits.reserve(rows.size());
+    store.rowActionCaps.reserve(rows.size());
+    store.actionCaps = actionCaps;
+    for (int c = 0; c < columns.size(); c++)
+        store.columns[c].reserve(rows.size());
+    for (int i = 0; i < rows.size(); i++)
+    {
+        int r = rows.at(i);
+        store.lines.append(lines.at(rowLines.at(r)));
+        store.rowLines.append(i);
+        store.rowBeans.append(rowBeans.at(r));
+        store.rowActionBits.append(rowActionBits.at(r));
+        store.rowActionCaps.append(rowActionCaps.at(r));
+        for (int c = 0; c < columns.size(); c++)
+        {
+            store.columns[c].append(columns.at(c).at(r));
+            store.updateWidest(i, c, columns.at(c).at(r));
+        }
+    }
+}
+
+/// 复制 other 的一行，文本追加到本结果中，偏移改为相对新的位置；other 的这一行可以在临时文件中
+void ResultStore::appendRowFrom(const ResultStore &other, int row)
+{
+    TextSpan line;
+    QStringRef lineText = other.rowLineRef(row);
+    line.start = buffer.size();
+    line.length = lineText.size();
+    int shift = line.start - lineText.position(); // 单元格和捕获组都在这一行内
+    buffer += lineText;
+    buffer += '\n';
+
+    rowLines.append(lines.size());
+    lines.append(line);
+    rowBeans.append(other.rowBean(row));
+    rowActionBits.append(other.rowActions(row));
+    clearTypedColumns();
+    for (int c = 0; c < columns.size(); c++)
+    {
+        TextSpan span = other.cellSpan(row, c);
+        if (span.start >= 0)
+            span.start += shift;
+        columns[c].append(span);
+        updateWidest(rowCount() - 1, c, span);
+    }
+
+    int count = other.actionCapCount(row);
+    rowActionCaps.append(count > 0 ? actionCaps.size() : -1);
+    for (int i = 0; i < count; i++)
+    {
+        TextSpan span = other.actionCapSpan(row, i);
+        if (span.start >= 0)
+            span.start += shift;
+        actionCaps.append(span);
+    }
+}
+
+/// 捕获组按行的顺序存放，一行的捕获组到下一个有捕获组的行为止
+int ResultStore::actionCapCount(int row) const
+{
+    if (row < spilledRows)
+    {
+        const ResultSpill::Chunk* chunk = spill->chunk(row);
+        int i = row - chunk->firstRow;
+        int offset = chunk->actionCapOffsets[i];
+        if (offset < 0)
+            return 0;
+        for (int k = i + 1; k < chunk->rowCount; k++)
+            if (chunk->actionCapOffsets[k] >= 0)
+                return chunk->actionCapOffsets[k] - offset;
+        return chunk->actionCapCount - offset;
+    }
+    int i = row - spilledRows;
+    int offset = rowActionCaps.at(i);
+    if (offset < 0)
+        return 0;
+    for (int k = i + 1; k < rowActionCaps.size(); k++)
+        if (rowActionCaps.at(k) >= 0)
+            return rowActionCaps.at(k) - offset;
+    return actionCaps.size() - offset;
+}
+
+TextSpan ResultStore::actionCapSpan(int row, int index) const
+{
+    if (row < spilledRows)
+    {
+        const ResultSpill::Chunk* chunk = spill->chunk(row);
+        return chunk->actionCaps[chunk->actionCapOffsets[row - chunk->firstRow] + index];
+    }
+    return actionCaps.at(rowActionCaps.at(row - spilledRows) + index);
+}
+
+const QVector<qint64> &ResultStore::numberColumn(int column) const
+{
+    if (numberColumns.size() != columns.size())
+        numberColumns.resize(columns.size());
+    QVector<qint64>& values = numberColumns[column];
+    if (values.size() != rowCount())
+    {
+        values.resize(rowCount());
+        for (int r = 0; r < values.size(); r++)
+        {
+            bool ok = false;
+            qint64 value = hasCell(r, column) ? cellRef(r, column).trimmed().toLongLong(&ok) : 0;
+            values[r] = ok ? value : missingNumber;
+        }
+    }
+    return values;
+}
+
+const QVector<AddressKey> &ResultStore::addressColumn(int column) const
+{
+    if (addressColumns.size() != columns.size())
+        addressColumns.resize(columns.size());
+    QVector<AddressKey>& values = addressColumns[column];
+    if (values.size() != rowCount())
+    {
+        values.resize(rowCount());
+        for (int r = 0; r < values.size(); r++)
+            values[r] = hasCell(r, column) ? AddressKey::parse(cellRef(r, column)) : AddressKey();
+    }
+    return values;
+}
+
+void ResultStore::clearTypedColumns()
+{
+    if (!numberColumns.isEmpty())
+        numberColumns.clear();
+    if (!addressColumns.isEmpty())
+        addressColumns.clear();
+}
+
+void ResultStore::updateWidest(int row, int column, const TextSpan &span)
+{
+    int widest = widestRows.at(column);
+    if (span.start >= 0 && (widest < 0 || span.length > cellSpan(widest, column).length))
+        widestRows[column] = row;
+}
+
+QStringRef ResultStore::spanRef(const TextSpan &span) const
+{
+    if (span.start < 0)
+        return QStringRef();
+    return QStringRef(&buffer, span.start, span.length);
+}
+
+/// 1.2.3.4:80、[::1]:80、:::22、0.0.0.0:*，没有冒号时整体为地址
+AddressKey AddressKey::parse(const QStringRef &text)
+{
+    AddressKey key;
+    QStringRef trimmed = text.trimmed();
+    if (trimmed.isEmpty())
+        return key;
+    key.valid = true;
+    int offset = trimmed.position() - text.position();
+    int colon = trimmed.lastIndexOf(':'); // 命令输出中的 IPv6 也以最后一个冒号分隔端口，如 :::22
+    QStringRef host = colon >= 0 ? trimmed.left(colon) : trimmed;
+    if (colon >= 0)
+    {
+        bool ok = false;
+        int port = trimmed.mid(colon + 1).toInt(&ok);
+        key.port = ok ? port : -1;
+    }
+    if (host.startsWith('[') && host.endsWith(']'))
+    {
+        host = host.mid(1, host.size() - 2);
+        offset++;
+    }
+    key.hostSpan.start = offset;
+    key.hostSpan.length = host.size();
+
+    QVector<QStringRef> parts = host.split('.');
+    if (parts.size() == 4)
+    {
+        qint64 value = 0;
+        for (const QStringRef& part: parts)
+        {
+            bool ok = false;
+            int byte = part.toInt(&ok);
+            if (!ok || byte < 0 || byte > 255)
+                return key;
+            value = (value << 8) | byte;
+        }
+        key.host = value;
+    }
+    return key;
+}
@@ -0,0 +1,111 @@
+#ifndef RESULTSTORE_H
+#define RESULTSTORE_H
+
+#include <QString>
+#include <QStringRef>
+#include <QVector>
+#include <QRegularExpression>
+#include <QSharedPointer>
+
+class ResultSpill;
+
+/**
+ * 解码后文本中的一段，不持有文本
+ */
+struct TextSpan
+{
+    int start = -1; // -1 表示没有（例如捕获组未参与匹配）
+    int length = 0;
+};
+
+/**
+ * ip:port 形式的单元格，按数值比较和排序
+ */
+struct AddressKey
+{
+    bool valid = false;
+    qint64 host = -1; // IPv4 的数值，其他地址（IPv6、*、主机名）为 -1，按文本比较
+    int port = -1; // 没有端口或为 * 时为 -1
+    TextSpan hostSpan; // 地址部分在单元格中的位置（相对单元格开头）
+
+    static AddressKey parse(const QStringRef& text);
+};
+
+/**
+ * 一次搜索的结果
+ * 命令输出解码后只保存这一份文本，行和单元格都是指向它的偏移/长度，
+ * 一次刷新只为文本分配内存，而不是每行每列各分配一次
+ * 设置了内存预算时，超出后最早的结果行写入临时文件（ResultSpill），读取时映射回来，行号不变
+ */
+class ResultStore
+{
+public:
+    void reset(int columnCount); // 清空结果，保留内存预算
+    void setMemoryBudget(qint64 bytes) { memoryBudget = qMax(qint64(0), bytes); } // 0 为不限制
+    qint64 memoryUsage() const; // 内存中的文本和偏移数组占用的字节数（估计值）
+    bool spillIfNeeded(); // 超出预算时写入最早的行，只能在一批输出匹配完之后调用
+    int spilledRowCount() const { return spilledRows; }
+
+    int appendText(const QString& text); // 追加完整的若干行，返回第一个新行的下标
+    const QString& text() const { return buffer; } // 内存中的部分，不含写入临时文件的行
+
+    int lineCount() const { return lines.size(); }
+    QStringRef lineRef(int line) const;
+
+    void appendRow(int line, int bean, const TextSpan* caps); // caps 长度为列数，动作全部可用
+    void appendCells(const QString* cells, int count, int bean = 0); // 直接追加已经分好列的一行
+    void removeFirstRows(int count); // 流式搜索丢弃最早的结果行（流式搜索不会写入临时文件）
+    void compact(); // 截掉文本中已经没有结果行引用的开头部分
+    int rowCount() const { return spilledRows + rowLines.size(); }
+    int columnCount() const { return columns.size(); }
+    int rowBean(int row) const;
+    void setRowActions(int row, quint64 actions, const TextSpan* caps, int count); // 行可用的动作（按位）和动作 exp 的捕获组
+    quint64 rowActions(int row) const;
+    QStringRef actionCapRef(int row, int index) const;
+    QStringRef rowLineRef(int row) const;
+    QString rowLine(int row) const;
+    QStringRef cellRef(int row, int column) const;
+    QString cell(int row, int column) const;
+    bool hasCell(int row, int column) const;
+    int widestRow(int column) const { return widestRows.at(column); } // 这一列字符数最多的行，-1 为没有
+
+    // 按类型解析的整列，第一次使用时解析并缓存，结果变化时清空；查询时按列批量比较
+    static const qint64 missingNumber;
+    const QVector<qint64>& numberColumn(int column) const; // 不是整数的单元格为 missingNumber
+    const QVector<AddressKey>& addressColumn(int column) const;
+
+    QVector<int> rowsContaining(const QString& key) const; // 整行包含 key 的结果行
+    QVector<int> rowsMatching(const QRegularExpression& re) const;
+    ResultStore subset(const QVector<int>& rows) const; // 只含指定行的结果，与本结果共享文本
+    void subsetInto(const QVector<int>& rows, ResultStore& store) const; // 同上，写入已有的 store
+
+private:
+    friend class ResultSpill;
+    QStringRef spanRef(const TextSpan& span) const;
+    TextSpan cellSpan(int row, int column) const;
+    int actionCapCount(int row) const;
+    TextSpan actionCapSpan(int row, int index) const;
+    void updateWidest(int row, int column, const TextSpan& span);
+    void clearTypedColumns();
+    void dropUnusedText();
+    void appendRowFrom(const ResultStore& other, int row);
+
+private:
+    QString buffer; // 本次搜索全部输出
+    QVector<TextSpan> lines; // 输出中的每一行（不含空行）
+    QVector<int> rowLines; // [行] 对应的输出行
+    QVector<int> rowBeans; // [行] 匹配到的 LineBean
+    QVector<QVector<TextSpan>> columns; // [列][行] 捕获组
+    QVector<quint64> rowActionBits; // [行] 右键菜单可用的动作
+    QVector<int> rowActionCaps; // [行] 在 actionCaps 中的起点，-1 为没有
+    QVector<TextSpan> actionCaps; // 各行动作 exp 的捕获组，按 LineBean::actionCapCount 连续存放
+    QVector<int> widestRows; // [列] 字符数最多的行，追加时顺便记录，调整列宽时不用遍历
+    mutable QVector<QVector<qint64>> numberColumns; // [列][行] 整数列的缓存，空为还没有解析
+    mutable QVector<QVector<AddressKey>> addressColumns; // [列][行] 地址列的缓存
+    int spilledRows = 0; // 前 spilledRows 行在 spill 中，以上各个 [行] 数组从这一行开始
+    QSharedPointer<ResultSpill> spill;
+    qint64 memoryBudget = 0;
+    bool spillFailed = false; // 临时文件不可用，本次搜索不再尝试
+};
+
+#endif // RESULTSTORE_H
@@ -0,0 +1,230 @@
+#include <QDebug>
+#include "searchrunner.h"
+#include "processlimiter.h"
+
+SearchRunner::SearchRunner(QObject *parent) : QObject(parent)
+{
+    timeoutTimer = new QTimer(this);
+    timeoutTimer->setSingleShot(true);
+    connect(timeoutTimer, SIGNAL(timeout()), this, SLOT(processTimeout()));
+    connect(ProcessLimiter::instance(), SIGNAL(available()), this, SLOT(limiterAvailable()), Qt::QueuedConnection);
+}
+
+SearchRunner::~SearchRunner()
+{
+    stopProcess();
+}
+
+quint64 SearchRunner::start(const CommandLine &cmd, int timeoutMs)
+{
+    stopProcess();
+    generation++;
+    startTime = SearchTrace::now();
+    receivedOutput = false;
+    waitingCmd = cmd;
+    waitingTimeout = timeoutMs;
+    waiting = true;
+    limiterAvailable();
+    return generation;
+}
+
+/// 占到进程名额后启动排队的命令，排队的时间计入启动耗时
+void SearchRunner::limiterAvailable()
+{
+    if (!waiting || !ProcessLimiter::instance()->acquire())
+        return ;
+    waiting = false;
+    holdsSlot = true;
+    launch();
+}
+
+void SearchRunner::launch()
+{
+    pending.clear();
+    errorBytes.clear();
+    decoder = QTextCodec::codecForLocale()->makeDecoder();
+    pipeline.build(waitingCmd.pipeStages());
+
+    process = new QProcess(this);
+    connect(process, SIGNAL(started()), this, SLOT(processStarted()));
+    connect(process, SIGNAL(readyReadStandardOutput()), this, SLOT(readStandardOutput()));
+    connect(process, SIGNAL(readyReadStandardError()), this, SLOT(readStandardError()));
+    connect(process, SIGNAL(finished(int, QProcess::ExitStatus)), this, SLOT(processFinished(int, QProcess::ExitStatus)));
+    connect(process, SIGNAL(errorOccurred(QProcess::ProcessError)), this, SLOT(processError(QProcess::ProcessError)));
+
+    waitingCmd.start(process); // 没有管道等 shell 语法时不经过 shell
+
+    if (waitingTimeout > 0)
+        timeoutTimer->start(waitingTimeout);
+}
+
+/// 取消当前搜索，已经发出的行保留，不再发出 finished
+void SearchRunner::cancel()
+{
+    if (!isRunning())
+        return ;
+    qInfo() << "search_cancelled";
+    stopProcess();
+}
+
+bool SearchRunner::isRunning() const
+{
+    return process != nullptr || waiting;
+}
+
+void SearchRunner::setTrace(SearchTrace *trace)
+{
+    this->trace = trace;
+}
+
+void SearchRunner::processStarted()
+{
+    if (trace)
+        trace->addSpan(SearchTrace::Exec, startTime, SearchTrace::now());
+}
+
+void SearchRunner::readStandardOutput()
+{
+    if (!process)
+        return ;
+    QByteArray bytes = process->readAllStandardOutput();
+    if (bytes.isEmpty())
+        return ;
+    if (!receivedOutput)
+    {
+        receivedOutput = true;
+        if (trace)
+            trace->addSpan(SearchTrace::FirstByte, startTime, SearchTrace::now());
+    }
+    {
+        SearchTrace::Scope scope(trace, SearchTrace::Decode);
+        pending += decoder->toUnicode(bytes);
+    }
+
+    // 只处理到最后一个换行符，剩下的半行留到下一块；管道命令与 shell 中一样只按 \n 分行
+    int end = pipeline.isEmpty() ? qMax(pending.lastIndexOf('\n'), pending.lastIndexOf('\r')) : pending.lastIndexOf('\n');
+    if (end < 0)
+        return ;
+    QString text = pending.left(end);
+    pending.remove(0, end + 1);
+    emitLines(text);
+}
+
+/// 经过进程内的管道命令后发出，head 读够时结束进程，相当于管道被关闭
+void SearchRunner::emitLines(const QString &text)
+{
+    if (pipeline.isEmpty())
+    {
+        emit outputReady(generation, text);
+        return ;
+    }
+
+    QString out;
+    bool hasOutput;
+    {
+        SearchTrace::Scope scope(trace, SearchTrace::Pipe);
+        pipeline.push(text);
+        hasOutput = pipeline.takeOutput(&out);
+    }
+    if (hasOutput)
+        emit outputReady(generation, out);
+    if (pipeline.isDone() && process && process->state() != QProcess::NotRunning)
+        process->kill();
+}
+
+void SearchRunner::readStandardError()
+{
+    if (process)
+        errorBytes += process->readAllStandardError();
+}
+
+void SearchRunner::processFinished(int exitCode, QProcess::ExitStatus status)
+{
+    readStandardOutput();
+    readStandardError();
+    if (trace)
+        trace->addSpan(SearchTrace::Read, startTime, SearchTrace::now());
+    flushPending();
+    QString error = QString::fromLocal8Bit(errorBytes);
+    if (error != "")
+        qWarning() << "error:" << error;
+    qInfo() << "exit_code:" << exitCode;
+
+    bool ok = (status == QProcess::NormalExit || pipeline.isDone());
+    stopProcess();
+    emit finished(generation, ok, ok ? error : "进程异常退出\n" + error);
+}
+
+void SearchRunner::processError(QProcess::ProcessError error)
+{
+    if (error != QProcess::FailedToStart || !process)
+        return ;
+    QString err = process->errorString();
+    qCritical() << "搜索命令启动失败：" << err;
+    stopProcess();
+    emit finished(generation, false, err);
+}
+
+void SearchRunner::processTimeout()
+{
+    if (!process)
+        return ;
+    qWarning() << "search_timeout";
+    readStandardOutput();
+    flushPending();
+    stopProcess();
+    emit finished(generation, false, "搜索超时，只显示已读取的结果");
+}
+
+/// 结束进程并断开所有信号，之后的输出都会被丢弃
+void SearchRunner::stopProcess()
+{
+    timeoutTimer->stop();
+    waiting = false;
+    if (process)
+    {
+        process->disconnect(this);
+        if (process->state() != QProcess::NotRunning)
+        {
+            // 不在界面线程等待退出，结束后再回收；提前删除时 QProcess 的析构会阻塞等待
+            connect(process, SIGNAL(finished(int, QProcess::ExitStatus)), process, SLOT(deleteLater()));
+            process->kill();
+        }
+        else
+        {
+            process->deleteLater();
+        }
+        process = nullptr;
+    }
+    if (decoder)
+    {
+        delete decoder;
+        decoder = nullptr;
+    }
+    if (holdsSlot)
+    {
+        holdsSlot = false;
+        ProcessLimiter::instance()->release();
+    }
+}
+
+void SearchRunner::flushPending()
+{
+    QString line = pending;
+    pending.clear();
+    if (!line.isEmpty())
+        emitLines(line);
+    if (pipeline.isEmpty())
+        return ;
+
+    // sort 等要等到命令结束才能输出
+    QString out;
+    bool hasOutput;
+    {
+        SearchTrace::Scope scope(trace, SearchTrace::Pipe);
+        pipeline.finish();
+        hasOutput = pipeline.takeOutput(&out);
+    }
+    if (hasOutput)
+        emit outputReady(generation, out);
+}
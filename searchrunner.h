@@ -0,0 +1,68 @@
+#ifndef SEARCHRUNNER_H
+#define SEARCHRUNNER_H
+
+#include <QObject>
+#include <QProcess>
+#include <QTimer>
+#include <QTextCodec>
+#include "searchtrace.h"
+#include "commandline.h"
+#include "linepipeline.h"
+
+/**
+ * 异步执行搜索命令
+ * 输出到达时立即解码，把其中完整的行通过 outputReady 分批发出，不阻塞界面线程
+ * 同一时间只运行一个命令，再次 start 会取消上一次
+ * 进程数达到 ProcessLimiter 的上限时先排队，有空位后再启动
+ * 命令末尾的 grep、head 等管道命令在发出前由 LinePipeline 执行，head 读够后结束进程
+ */
+class SearchRunner : public QObject
+{
+    Q_OBJECT
+public:
+    explicit SearchRunner(QObject *parent = nullptr);
+    ~SearchRunner() override;
+
+    quint64 start(const CommandLine& cmd, int timeoutMs = 0); // 返回这次搜索的代数
+    void cancel();
+    bool isRunning() const; // 排队等待启动时也为 true
+    void setTrace(SearchTrace* trace); // 记录启动、首字节、读取和解码的耗时，可为空
+
+signals:
+    // generation 为 start 返回的代数，接收方据此丢弃过期的结果
+    void outputReady(quint64 generation, const QString& text); // 一批完整的行，不含最后的换行符
+    void finished(quint64 generation, bool ok, const QString& error); // 超时、启动失败时 ok 为 false，取消时不发出
+
+private slots:
+    void processStarted();
+    void readStandardOutput();
+    void readStandardError();
+    void processFinished(int exitCode, QProcess::ExitStatus status);
+    void processError(QProcess::ProcessError error);
+    void processTimeout();
+    void limiterAvailable();
+
+private:
+    void launch();
+    void stopProcess();
+    void flushPending();
+    void emitLines(const QString& text);
+
+private:
+    QProcess* process = nullptr;
+    QTextDecoder* decoder = nullptr; // 有状态的解码器，多字节字符跨块时不会乱码
+    LinePipeline pipeline; // 进程内的管道命令
+    QString pending; // 还没读到换行的最后一行
+    QByteArray errorBytes;
+    QTimer* timeoutTimer = nullptr;
+    CommandLine waitingCmd; // 排队等待启动的命令
+    int waitingTimeout = 0;
+    bool waiting = false;
+    bool holdsSlot = false; // 是否占用了 ProcessLimiter 的名额
+    quint64 generation = 0;
+    SearchTrace* trace = nullptr;
+    qint64 startTime = 0;
+    bool receivedOutput = false;
+};
+
+#endif // SEARCHRUNNER_H
@@ -0,0 +1,131 @@
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QStringList>
+#include "searchtrace.h"
+
+/// 从第一次调用开始计时，+1 保证不会返回 0
+qint64 SearchTrace::now()
+{
+    static QElapsedTimer clock;
+    if (!clock.isValid())
+        clock.start();
+    return clock.nsecsElapsed() + 1;
+}
+
+void SearchTrace::begin(const QString &label)
+{
+    this->label = label;
+    origin = now();
+    finish = 0;
+    originAllocs = allocationCount();
+    finishAllocs = 0;
+    spans.clear();
+}
+
+void SearchTrace::end()
+{
+    if (!isActive())
+        return ;
+    finish = now();
+    finishAllocs = allocationCount();
+}
+
+void SearchTrace::addSpan(Stage stage, qint64 begin, qint64 end, quint64 allocs)
+{
+    if (!isActive())
+        return ;
+    Span span;
+    span.stage = stage;
+    span.begin = begin;
+    span.duration = end - begin;
+    span.allocs = allocs;
+    spans.append(span);
+}
+
+quint64 SearchTrace::stageAllocs(Stage stage) const
+{
+    quint64 total = 0;
+    for (const Span& span: spans)
+        if (span.stage == stage)
+            total += span.allocs;
+    return total;
+}
+
+quint64 SearchTrace::totalAllocs() const
+{
+    return (finish ? finishAllocs : allocationCount()) - originAllocs;
+}
+
+qint64 SearchTrace::stageNs(Stage stage) const
+{
+    qint64 total = 0;
+    for (const Span& span: spans)
+        if (span.stage == stage)
+            total += span.duration;
+    return total;
+}
+
+const char *SearchTrace::stageName(Stage stage)
+{
+    static const char* names[StageCount] = {
+        "exec", "first_byte", "read", "decode", "pipe", "split", "match", "filter", "model", "resize"
+    };
+    return names[stage];
+}
+
+qint64 SearchTrace::totalNs() const
+{
+    return (finish ? finish : now()) - origin;
+}
+
+/// 例如：启动 2ms · 首字节 9ms · 读取 85ms · 解码 3ms · 分行 1ms · 匹配 21ms · 表格 4ms · 列宽 12ms · 分配 1520 次 · 共 120ms
+QString SearchTrace::summary() const
+{
+    static const char* labels[StageCount] = {
+        "启动", "首字节", "读取", "解码", "管道", "分行", "匹配", "筛选", "表格", "列宽"
+    };
+    auto ms = [](qint64 ns) { return QString::number(ns / 1e6, 'f', ns < 10000000 ? 1 : 0) + "ms"; };
+
+    bool found[StageCount] = {};
+    for (const Span& span: spans)
+        found[span.stage] = true;
+    QStringList parts;
+    for (int stage = 0; stage < StageCount; stage++)
+        if (found[stage])
+            parts.append(QString(labels[stage]) + " " + ms(stageNs(Stage(stage))));
+    if (allocationCountAvailable())
+        parts.append(QString("分配 %1 次").arg(totalAllocs()));
+    parts.append("共 " + ms(totalNs()));
+    return parts.join(" · ");
+}
+
+/**
+ * 整次搜索为一个事件，各阶段为嵌套在其中的事件（ph=X，单位微秒）
+ * 启动、首字节、读取从搜索开始算起，放在单独的一行，避免与分批的解析重叠
+ * 支持统计时 args.allocs 为这一段内的分配次数（从搜索开始算起的几段没有）
+ */
+void SearchTrace::appendTraceEvents(QJsonArray &events, int tid) const
+{
+    if (!origin)
+        return ;
+    auto event = [&](const QString& name, qint64 begin, qint64 duration, int eventTid, qint64 allocs) {
+        QJsonObject obj;
+        obj.insert("name", name);
+        obj.insert("cat", "search");
+        obj.insert("ph", "X");
+        obj.insert("ts", begin / 1000.0);
+        obj.insert("dur", duration / 1000.0);
+        obj.insert("pid", 1);
+        obj.insert("tid", eventTid);
+        if (allocs >= 0 && allocationCountAvailable())
+            obj.insert("args", QJsonObject{{"allocs", double(allocs)}});
+        events.append(obj);
+    };
+
+    event(label, origin, totalNs(), tid * 2, qint64(totalAllocs()));
+    for (const Span& span: spans)
+    {
+        bool fromStart = span.stage == Exec || span.stage == FirstByte || span.stage == Read;
+        event(stageName(span.stage), span.begin, span.duration, tid * 2 + (fromStart ? 1 : 0), fromStart ? -1 : qint64(span.allocs));
+    }
+}
@@ -0,0 +1,80 @@
+#ifndef SEARCHTRACE_H
+#define SEARCHTRACE_H
+
+#include <QString>
+#include <QVector>
+#include <QJsonArray>
+#include "alloccounter.h"
+
+/**
+ * 一次搜索各阶段的耗时
+ * 每段记录开始时间和时长（纳秒，进程内单调时钟），同一阶段的多段（例如每批的匹配）合计显示，
+ * 也可以按 Chrome trace event 格式导出，在 chrome://tracing 或 Perfetto 中查看
+ * 支持统计时（glibc）同时记录每段和整次搜索期间的 malloc 次数
+ */
+class SearchTrace
+{
+public:
+    enum Stage
+    {
+        Exec, // 启动进程：start -> started
+        FirstByte, // start -> 第一次收到输出
+        Read, // start -> 进程结束（内置数据源为读取耗时）
+        Decode, // 字节解码为文本
+        Pipe, // 进程内的管道命令（grep、sort 等）
+        Split, // 文本切分为行
+        Match, // 行匹配
+        Filter, // 进程内按关键词筛选
+        Model, // 表格模型更新
+        Resize, // 调整列宽
+        StageCount
+    };
+
+    struct Span
+    {
+        Stage stage;
+        qint64 begin;
+        qint64 duration;
+        quint64 allocs; // 这一段内的分配次数（所有线程）
+    };
+
+    static qint64 now();
+
+    void begin(const QString& label);
+    void end();
+    bool isActive() const { return origin > 0 && finish == 0; }
+    QString name() const { return label; }
+
+    void addSpan(Stage stage, qint64 begin, qint64 end, quint64 allocs = 0);
+    qint64 stageNs(Stage stage) const; // 同一阶段的多段合计
+    quint64 stageAllocs(Stage stage) const;
+    quint64 totalAllocs() const; // begin 到 end 之间的分配次数，包括事件循环中其他的分配
+    static const char* stageName(Stage stage);
+    qint64 totalNs() const;
+
+    QString summary() const; // 状态栏中显示的一行
+    void appendTraceEvents(QJsonArray& events, int tid) const;
+
+    /// 作用域内的耗时记为一段
+    class Scope
+    {
+    public:
+        Scope(SearchTrace* trace, Stage stage) : trace(trace), stage(stage), begin(now()), allocs(allocationCount()) {}
+        ~Scope() { if (trace) trace->addSpan(stage, begin, now(), allocationCount() - allocs); }
+    private:
+        SearchTrace* trace;
+        Stage stage;
+        qint64 begin;
+        quint64 allocs;
+    };
+
+private:
+    QString label;
+    qint64 origin = 0;
+    qint64 finish = 0;
+    quint64 originAllocs = 0;
+    quint64 finishAllocs = 0;
+    QVector<Span> spans;
+};
+
+#endif // SEARCHTRACE_H